@@ -0,0 +1,64 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// BoundedQueue hands items from one thread to another, holding at most
+// capacity of them, so a producer can only run that far ahead of whoever
+// consumes what it makes. Pushing blocks while the queue is full, popping
+// blocks while it is empty. Once closed, pushes are refused and pops drain
+// what is left, then fail, which wakes up and stops both sides.
+template <class T>
+class BoundedQueue {
+  std::deque<T> items;
+  unsigned int capacity;
+  bool closed;
+  std::mutex lock;
+  std::condition_variable not_full;
+  std::condition_variable not_empty;
+
+ public:
+  BoundedQueue(unsigned int capacity) : capacity(capacity), closed(false){};
+
+  // add an item, waiting for room. false if the queue is closed, in which
+  // case the item is dropped.
+  bool push(T item) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    this->not_full.wait(guard, [this] {
+      return this->closed || this->items.size() < this->capacity;
+    });
+    if (this->closed) {
+      return false;
+    }
+    this->items.push_back(std::move(item));
+    this->not_empty.notify_one();
+    return true;
+  };
+  // take the oldest item, waiting for one. false once the queue is closed
+  // and empty.
+  bool pop(T& item) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    this->not_empty.wait(
+        guard, [this] { return this->closed || !this->items.empty(); });
+    if (this->items.empty()) {
+      return false;
+    }
+    item = std::move(this->items.front());
+    this->items.pop_front();
+    this->not_full.notify_one();
+    return true;
+  };
+  void close() {
+    std::lock_guard<std::mutex> guard(this->lock);
+    this->closed = true;
+    this->not_full.notify_all();
+    this->not_empty.notify_all();
+  };
+  unsigned int size() {
+    std::lock_guard<std::mutex> guard(this->lock);
+    return this->items.size();
+  };
+};
+#endif
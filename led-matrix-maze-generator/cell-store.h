@@ -0,0 +1,139 @@
+#ifndef CELL_STORE_H
+#define CELL_STORE_H
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "cell.h"
+#include "checkpoint.h"
+#include "footprint.h"
+#include "grid-dimensions.h"
+#include "packed-bitset.h"
+
+// CellStore holds the per cell data of a Grid. The generic store keeps an
+// array of T sized by the Grid's dimension policy, so any cell type can be
+// used with a Grid.
+template <class T, class Dims = DynamicDimensions>
+class CellStore {
+  using CellListFmt = typename Dims::template Array<T>;
+  CellListFmt cells;
+
+ public:
+  // reference lets a cell be modified in place.
+  using reference = typename CellListFmt::reference;
+
+  CellStore(const Dims& dims) : cells(dims.template makeArray<T>(T())){};
+
+  T get(unsigned int id) const { return this->cells.at(id); }
+  void set(unsigned int id, T cell) { this->cells.at(id) = cell; }
+  reference at(unsigned int id) { return this->cells.at(id); }
+  unsigned int size() const { return this->cells.size(); }
+  // put every cell back to a default T, in place.
+  void reset() { std::fill(this->cells.begin(), this->cells.end(), T()); }
+  // bytes allocated for the cells.
+  size_t footprint() const { return storageFootprint(this->cells); }
+
+  // bulk queries, only available when T has a visited member.
+  unsigned int firstUnvisitedFrom(unsigned int id) const {
+    while (id < this->cells.size() && this->cells[id].visited) {
+      id++;
+    }
+    return id < this->cells.size() ? id : this->cells.size();
+  }
+  unsigned int countVisited() const {
+    unsigned int total = 0;
+    for (auto& cell : this->cells) {
+      total += cell.visited ? 1 : 0;
+    }
+    return total;
+  }
+
+  // write or read the cells to a checkpoint, only available when T is
+  // trivially copyable.
+  void saveState(std::ostream& out) const {
+    for (unsigned int id = 0; id < this->cells.size(); id++) {
+      writeCheckpointValue<T>(out, this->cells[id]);
+    }
+  }
+  void loadState(std::istream& in) {
+    for (unsigned int id = 0; id < this->cells.size(); id++) {
+      this->cells[id] = readCheckpointValue<T>(in);
+    }
+  }
+};
+
+// Cells are stored as a structure of arrays, one packed bitset per flag, so
+// flipping a flag touches a single bit and the bulk queries run a word at a
+// time. The bitsets are allocated once, when the store is created.
+template <class Dims>
+class CellStore<Cell, Dims> {
+  PackedBitset visited;
+  PackedBitset emphasized;
+
+  void checkId(unsigned int id) const {
+    if (id >= this->visited.size()) {
+      throw std::out_of_range("cell id is outside of the cell store.");
+    }
+  }
+
+ public:
+  // reference is a proxy which exposes each flag as an assignable bit.
+  struct reference {
+    PackedBitset::reference visited;
+    PackedBitset::reference emphasized;
+    operator Cell() const {
+      Cell c;
+      c.visited = this->visited;
+      c.emphasized = this->emphasized;
+      return c;
+    }
+    reference& operator=(const Cell& c) {
+      this->visited = c.visited;
+      this->emphasized = c.emphasized;
+      return *this;
+    }
+  };
+
+  CellStore(const Dims& dims)
+      : visited(dims.num_cells), emphasized(dims.num_cells){};
+
+  Cell get(unsigned int id) const {
+    this->checkId(id);
+    Cell c;
+    c.visited = this->visited.test(id);
+    c.emphasized = this->emphasized.test(id);
+    return c;
+  }
+  void set(unsigned int id, Cell cell) {
+    this->checkId(id);
+    this->visited.set(id, cell.visited);
+    this->emphasized.set(id, cell.emphasized);
+  }
+  reference at(unsigned int id) {
+    this->checkId(id);
+    return reference{this->visited[id], this->emphasized[id]};
+  }
+  unsigned int size() const { return this->visited.size(); }
+  void reset() {
+    this->visited.clear();
+    this->emphasized.clear();
+  }
+  size_t footprint() const {
+    return this->visited.footprint() + this->emphasized.footprint();
+  }
+
+  unsigned int firstUnvisitedFrom(unsigned int id) const {
+    return this->visited.findFirstUnset(id);
+  }
+  unsigned int countVisited() const { return this->visited.count(); }
+
+  void saveState(std::ostream& out) const {
+    this->visited.saveState(out);
+    this->emphasized.saveState(out);
+  }
+  void loadState(std::istream& in) {
+    this->visited.loadState(in);
+    this->emphasized.loadState(in);
+  }
+};
+#endif
@@ -0,0 +1,63 @@
+#include "change-journal.h"
+
+#include "footprint.h"
+
+void ChangeJournal::recordCell(unsigned int id) {
+  if (this->observer != nullptr) {
+    this->observer->cellModified(id);
+  }
+  if (this->dirty_cells.test(id)) {
+    return;
+  }
+  this->dirty_cells.set(id);
+  this->cells.push_back(id);
+}
+
+void ChangeJournal::recordConnection(unsigned int id_a, unsigned int id_b,
+                                     unsigned int slot) {
+  if (this->observer != nullptr) {
+    this->observer->connectionModified(id_a, id_b);
+  }
+  if (this->dirty_connections.test(slot)) {
+    return;
+  }
+  this->dirty_connections.set(slot);
+  this->connections.push_back(
+      std::tuple<unsigned int, unsigned int>(id_a, id_b));
+  this->connection_slots.push_back(slot);
+}
+
+void ChangeJournal::drainCells(IdListFmt& out) {
+  out.clear();
+  out.swap(this->cells);
+  for (auto& id : out) {
+    this->dirty_cells.reset(id);
+  }
+}
+
+void ChangeJournal::drainConnections(ConnectionListFmt& out) {
+  out.clear();
+  out.swap(this->connections);
+  for (auto& slot : this->connection_slots) {
+    this->dirty_connections.reset(slot);
+  }
+  this->connection_slots.clear();
+}
+
+void ChangeJournal::clear() {
+  for (auto& id : this->cells) {
+    this->dirty_cells.reset(id);
+  }
+  this->cells.clear();
+  for (auto& slot : this->connection_slots) {
+    this->dirty_connections.reset(slot);
+  }
+  this->connections.clear();
+  this->connection_slots.clear();
+}
+
+size_t ChangeJournal::footprint() const {
+  return this->dirty_cells.footprint() + this->dirty_connections.footprint() +
+         storageFootprint(this->cells) + storageFootprint(this->connections) +
+         storageFootprint(this->connection_slots);
+}
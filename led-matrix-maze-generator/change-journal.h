@@ -0,0 +1,71 @@
+#ifndef CHANGE_JOURNAL_H
+#define CHANGE_JOURNAL_H
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "packed-bitset.h"
+
+// GridObserver can be registered with a Grid to be told about each change as
+// it happens, rather than polling for them.
+struct GridObserver {
+  virtual ~GridObserver(){};
+  virtual void cellModified(unsigned int id) = 0;
+  virtual void connectionModified(unsigned int id_a, unsigned int id_b) = 0;
+};
+
+/* ChangeJournal Overview
+ *
+ * The journal records which cells and connections of a Grid have been
+ * modified since a consumer last drained it.
+ *
+ * Each cell and each connection is recorded at most once between drains, a
+ * dirty bit is kept per cell and per connection slot so repeated
+ * modifications are dropped in O(1). Connection slots are chosen by the
+ * Grid, so that both orderings of the same pair of cells share a slot.
+ *
+ * Draining swaps the recorded list with the (cleared) buffer handed in by
+ * the consumer, so nothing is copied, and a consumer that keeps its buffer
+ * around never causes an allocation once the buffers have grown.
+ * */
+class ChangeJournal {
+ public:
+  using IdListFmt = std::vector<unsigned int>;
+  using ConnectionListFmt = std::vector<std::tuple<unsigned int, unsigned int>>;
+
+ private:
+  PackedBitset dirty_cells;
+  PackedBitset dirty_connections;
+  IdListFmt cells;
+  ConnectionListFmt connections;
+  // slot of each recorded connection, so its dirty bit can be reset.
+  IdListFmt connection_slots;
+  GridObserver* observer;
+
+ public:
+  ChangeJournal(unsigned int num_cells, unsigned int num_connection_slots)
+      : dirty_cells(num_cells),
+        dirty_connections(num_connection_slots),
+        observer(nullptr){};
+
+  // record a modified cell.
+  void recordCell(unsigned int id);
+  // record a modified connection, which is identified by its slot.
+  void recordConnection(unsigned int id_a, unsigned int id_b,
+                        unsigned int slot);
+  // view the changes recorded since the last drain.
+  const IdListFmt& peekCells() const { return this->cells; }
+  const ConnectionListFmt& peekConnections() const {
+    return this->connections;
+  }
+  // hand the recorded changes to the consumer and start over.
+  void drainCells(IdListFmt& out);
+  void drainConnections(ConnectionListFmt& out);
+  // drop everything recorded since the last drain, keeping the buffers.
+  void clear();
+  // bytes allocated for the dirty bits and recorded changes.
+  size_t footprint() const;
+  // register an observer to be told of every change, nullptr to remove it.
+  void setObserver(GridObserver* o) { this->observer = o; }
+};
+#endif
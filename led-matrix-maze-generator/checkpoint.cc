@@ -0,0 +1,70 @@
+#include "checkpoint.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+
+void writeCheckpointBytes(std::ostream& out, const void* data, size_t size) {
+  out.write(static_cast<const char*>(data), size);
+  if (!out) {
+    throw CheckpointException();
+  }
+}
+
+void readCheckpointBytes(std::istream& in, void* data, size_t size) {
+  in.read(static_cast<char*>(data), size);
+  if (!in) {
+    throw CheckpointException();
+  }
+}
+
+void replaceCheckpointFile(const std::string& path,
+                           const std::string& contents) {
+  const std::string tmp_path = path + ".tmp";
+  int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw CheckpointException();
+  }
+  const char* data = contents.data();
+  size_t remaining = contents.size();
+  while (remaining > 0) {
+    ssize_t written = write(fd, data, remaining);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      close(fd);
+      throw CheckpointException();
+    }
+    data += written;
+    remaining -= written;
+  }
+  // the data must be on disk before the rename can make it the checkpoint.
+  if (fsync(fd) != 0) {
+    close(fd);
+    throw CheckpointException();
+  }
+  if (close(fd) != 0) {
+    throw CheckpointException();
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    throw CheckpointException();
+  }
+
+  // the rename lives in the directory, sync that too so it survives.
+  const size_t slash = path.find_last_of('/');
+  const std::string dir = slash == std::string::npos
+                              ? "."
+                              : (slash == 0 ? "/" : path.substr(0, slash));
+  int dir_fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dir_fd < 0) {
+    throw CheckpointException();
+  }
+  const bool synced = fsync(dir_fd) == 0;
+  close(dir_fd);
+  if (!synced) {
+    throw CheckpointException();
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "maze-exceptions.h"
+
+/* Checkpoint Overview
+ *
+ * A checkpoint is a compact binary snapshot of a maze in the middle of
+ * generation, so generation can be resumed after the process is stopped.
+ * Values are written in the native byte order of the machine, checkpoints
+ * are meant to be resumed on the board that wrote them.
+ *
+ * Each component writes its own section with the helpers below, in this
+ * order:
+ *
+ *   header      magic number and format version, written by Maze.
+ *   maze        whether generation has completed.
+ *   grid        dimensions and direction count, which must match on resume,
+ *               then the connected mask of every cell and the cell data.
+ *   strategy    whatever the generation strategy needs to carry on,
+ *               including the state of its random number generator, so a
+ *               resumed maze comes out as it would have without the stop.
+ *
+ * Every read failure or mismatch throws a CheckpointException.
+ * */
+
+#define CHECKPOINT_MAGIC 0x315a4d4c  // "LMZ1"
+#define CHECKPOINT_VERSION 2
+
+// write or read a block of raw bytes.
+void writeCheckpointBytes(std::ostream&, const void*, size_t);
+void readCheckpointBytes(std::istream&, void*, size_t);
+
+// replace the file at path with contents. the contents are written next to
+// it and synced to disk before being renamed over it, and the rename is
+// synced too, so after a crash or power loss the file holds either the old
+// checkpoint or the new one, never part of one.
+void replaceCheckpointFile(const std::string& path,
+                           const std::string& contents);
+
+// write or read a single plain value.
+template <class V>
+void writeCheckpointValue(std::ostream& out, const V& value) {
+  writeCheckpointBytes(out, &value, sizeof(V));
+}
+
+template <class V>
+V readCheckpointValue(std::istream& in) {
+  V value;
+  readCheckpointBytes(in, &value, sizeof(V));
+  return value;
+}
+
+// read a value which must match the expected one.
+template <class V>
+void expectCheckpointValue(std::istream& in, const V& expected) {
+  if (readCheckpointValue<V>(in) != expected) {
+    throw CheckpointException();
+  }
+}
+#endif
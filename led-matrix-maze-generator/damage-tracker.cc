@@ -0,0 +1,18 @@
+#include "damage-tracker.h"
+
+DamageTracker::DamageTracker(unsigned int num_rows, unsigned int num_cols)
+    : num_rows(num_rows),
+      num_cols(num_cols),
+      stride((num_cols + PackedBitset::bits_per_word - 1) /
+             PackedBitset::bits_per_word * PackedBitset::bits_per_word),
+      dirty(num_rows * stride),
+      dirty_rows(num_rows) {}
+
+void DamageTracker::clear() {
+  this->dirty.clear();
+  this->dirty_rows.clear();
+}
+
+size_t DamageTracker::footprint() const {
+  return this->dirty.footprint() + this->dirty_rows.footprint();
+}
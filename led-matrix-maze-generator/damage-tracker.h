@@ -0,0 +1,87 @@
+#ifndef DAMAGE_TRACKER_H
+#define DAMAGE_TRACKER_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "frame-buffer.h"
+#include "packed-bitset.h"
+
+/* DamageTracker Overview
+ *
+ * Tracks which pixels of a canvas have changed since they were last drawn,
+ * with a dirty bit per pixel and a dirty bit per row:
+ *
+ *   dirty       a bit per pixel, each row padded out to whole words, so a
+ *               row never shares a word with the next.
+ *   dirty_rows  a bit per row with any dirty pixel in it.
+ *
+ * Marking a pixel is two bit sets, however often the pixel changes. A
+ * flush visits only the dirty rows, and finds the runs of dirty pixels
+ * along each of them a word at a time, handing each run out once:
+ *
+ *   row 3   . . X X X . . X .    gives (3, 2, 3) and (3, 7, 1)
+ *
+ * Runs come out in row order, then column order, and nothing is sorted or
+ * allocated. A canvas that can take a run in one call, see SetPixelRun
+ * below, is drawn a run at a time.
+ * */
+class DamageTracker {
+  unsigned int num_rows;
+  unsigned int num_cols;
+  // bits per row of the pixel bitset, a whole number of words.
+  unsigned int stride;
+  PackedBitset dirty;
+  PackedBitset dirty_rows;
+
+ public:
+  DamageTracker(unsigned int num_rows, unsigned int num_cols);
+
+  void mark(unsigned int row, unsigned int col) {
+    this->dirty.set(row * this->stride + col);
+    this->dirty_rows.set(row);
+  }
+  bool isDirty(unsigned int row, unsigned int col) const {
+    return this->dirty.test(row * this->stride + col);
+  }
+  bool empty() const {
+    return this->dirty_rows.findFirstSet(0) >= this->num_rows;
+  }
+  // hand each run of dirty pixels to emit(row, first_col, count), and mark
+  // them clean.
+  template <class Emit>
+  void flush(Emit emit);
+  // mark everything clean without handing anything out.
+  void clear();
+  // bytes allocated for the dirty bits.
+  size_t footprint() const;
+};
+
+// HasSetPixelRun tells whether a canvas can draw a run of pixels along a
+// row in one call, as SetPixelRun(x, y, rgb, count) with the pixels packed
+// as in a FrameBuffer, which saves a call (and maybe a lock) per pixel.
+template <class Canvas, class = void>
+struct HasSetPixelRun : std::false_type {};
+template <class Canvas>
+struct HasSetPixelRun<
+    Canvas, std::void_t<decltype(std::declval<Canvas&>().SetPixelRun(
+                0, 0, std::declval<const uint8_t*>(), 0))>>
+    : std::true_type {};
+
+// draw count packed RGB888 pixels from (x, y) to the right, in one call if
+// the canvas can take a run, a pixel at a time if not.
+template <class Canvas>
+void drawPixelRun(Canvas* canvas, int x, int y, const uint8_t* rgb,
+                  int count) {
+  if constexpr (HasSetPixelRun<Canvas>::value) {
+    canvas->SetPixelRun(x, y, rgb, count);
+  } else {
+    for (int i = 0; i < count; i++, rgb += FrameBuffer::bytes_per_pixel) {
+      canvas->SetPixel(x + i, y, rgb[0], rgb[1], rgb[2]);
+    }
+  }
+}
+#include "damage-tracker_impl.h"
+#endif
@@ -0,0 +1,20 @@
+template <class Emit>
+void DamageTracker::flush(Emit emit) {
+  for (unsigned int row = this->dirty_rows.findFirstSet(0);
+       row < this->num_rows; row = this->dirty_rows.findFirstSet(row + 1)) {
+    const unsigned int row_begin = row * this->stride;
+    const unsigned int row_end = row_begin + this->num_cols;
+    unsigned int first = this->dirty.findFirstSet(row_begin);
+    while (first < row_end) {
+      // a run ends at the end of its row, whatever the next row holds.
+      const unsigned int last =
+          std::min(this->dirty.findFirstUnset(first), row_end);
+      for (unsigned int i = first; i < last; i++) {
+        this->dirty.reset(i);
+      }
+      emit(row, first - row_begin, last - first);
+      first = this->dirty.findFirstSet(last);
+    }
+    this->dirty_rows.reset(row);
+  }
+}
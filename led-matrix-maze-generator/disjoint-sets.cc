@@ -0,0 +1,49 @@
+#include "disjoint-sets.h"
+
+#include "footprint.h"
+
+DisjointSets::DisjointSets(unsigned int size) : parent(size), rank(size, 0) {
+  this->reset();
+}
+
+unsigned int DisjointSets::find(unsigned int id) {
+  unsigned int root = id;
+  while (this->parent[root] != root) {
+    root = this->parent[root];
+  }
+  // point everything on the path straight at the root.
+  while (this->parent[id] != root) {
+    unsigned int next = this->parent[id];
+    this->parent[id] = root;
+    id = next;
+  }
+  return root;
+}
+
+bool DisjointSets::unite(unsigned int a, unsigned int b) {
+  a = this->find(a);
+  b = this->find(b);
+  if (a == b) {
+    return false;
+  }
+  if (this->rank[a] < this->rank[b]) {
+    this->parent[a] = b;
+  } else if (this->rank[a] > this->rank[b]) {
+    this->parent[b] = a;
+  } else {
+    this->parent[b] = a;
+    this->rank[a]++;
+  }
+  return true;
+}
+
+void DisjointSets::reset() {
+  for (unsigned int id = 0; id < this->parent.size(); id++) {
+    this->parent[id] = id;
+    this->rank[id] = 0;
+  }
+}
+
+size_t DisjointSets::footprint() const {
+  return storageFootprint(this->parent) + storageFootprint(this->rank);
+}
@@ -0,0 +1,27 @@
+#ifndef DISJOINT_SETS_H
+#define DISJOINT_SETS_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// DisjointSets is a union-find forest over the ids [0, size), kept in flat
+// arrays. Sets are joined by rank, and finds compress the path they walk,
+// so any sequence of operations runs in near constant amortized time each.
+class DisjointSets {
+  std::vector<unsigned int> parent;
+  std::vector<uint8_t> rank;
+
+ public:
+  DisjointSets(unsigned int size);
+
+  // the representative of the set holding id.
+  unsigned int find(unsigned int id);
+  // join the sets holding a and b, false if they were already one set.
+  bool unite(unsigned int a, unsigned int b);
+  // put every id back in a set of its own.
+  void reset();
+  unsigned int size() const { return this->parent.size(); }
+  // bytes allocated for the forest.
+  size_t footprint() const;
+};
+#endif
@@ -0,0 +1,77 @@
+#ifndef DOUBLE_BUFFERED_CANVAS_H
+#define DOUBLE_BUFFERED_CANVAS_H
+#include <cstdint>
+#include <vector>
+
+/* DoubleBufferedCanvas Overview
+ *
+ * Draws on an offscreen frame rather than on the panel, and puts the frame
+ * on show with a swap on the panel's vertical sync, so the refresh thread
+ * only ever shows whole frames, never one half drawn.
+ *
+ * The matrix keeps two frames, the one on show and the one being drawn.
+ * A swap hands back the frame that was on show, which is a frame behind,
+ * so the writes of the frame just shown are kept and replayed onto it:
+ *
+ *   draw frame n on the back frame
+ *   swap, the back frame is now the one that shows frame n - 1
+ *   replay the writes of frame n onto it
+ *   draw frame n + 1 ...
+ *
+ * A frame that changes a handful of pixels costs a handful of writes twice
+ * rather than a copy of the whole frame. The first frame drawn should set
+ * every pixel, as a Maze does, so the two frames agree from then on.
+ *
+ * Matrix is anything with CreateFrameCanvas() and SwapOnVSync(Frame*),
+ * such as rgb_matrix::RGBMatrix, and Frame is anything with SetPixel,
+ * width and height, such as rgb_matrix::FrameCanvas. The matrix owns its
+ * frames.
+ * */
+template <class Matrix, class Frame>
+class DoubleBufferedCanvas {
+  struct Write {
+    int x;
+    int y;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+  };
+  Matrix* matrix;
+  // the frame being drawn.
+  Frame* back;
+  // writes made to the back frame since the last swap.
+  std::vector<Write> pending;
+
+ public:
+  DoubleBufferedCanvas(Matrix* m) : matrix(m), back(m->CreateFrameCanvas()){};
+  int width() { return this->back->width(); };
+  int height() { return this->back->height(); };
+  void SetPixel(int x, int y, int r, int g, int b) {
+    this->back->SetPixel(x, y, r, g, b);
+    this->pending.push_back(Write{x, y, uint8_t(r), uint8_t(g), uint8_t(b)});
+  };
+  // show what has been drawn, waiting for the vertical sync, and bring the
+  // new back frame up to date. does nothing if nothing has been drawn.
+  void present() {
+    if (this->pending.empty()) {
+      return;
+    }
+    this->back = this->matrix->SwapOnVSync(this->back);
+    for (auto& w : this->pending) {
+      this->back->SetPixel(w.x, w.y, w.r, w.g, w.b);
+    }
+    this->pending.clear();
+  };
+  // writes waiting for the next swap.
+  unsigned int pendingWrites() const { return this->pending.size(); }
+};
+
+// show a frame once it is drawn. Only canvases that draw offscreen have
+// anything to do, every other canvas shows each pixel as it is set.
+template <class Canvas>
+void presentFrame(Canvas*) {}
+template <class Matrix, class Frame>
+void presentFrame(DoubleBufferedCanvas<Matrix, Frame>* canvas) {
+  canvas->present();
+}
+#endif
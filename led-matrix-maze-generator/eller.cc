@@ -0,0 +1,101 @@
+#include "eller.h"
+
+#include "footprint.h"
+
+EllerRowGenerator::EllerRowGenerator(unsigned int num_cols, Rng rng)
+    : num_cols(num_cols),
+      rng(rng),
+      sets(num_cols),
+      east_passages(num_cols),
+      south_passages(num_cols),
+      set_sizes(num_cols, 0),
+      set_downs(num_cols, 0),
+      set_picks(num_cols, 0),
+      labels_in_use(num_cols) {
+  // every cell of the first row starts in a set of its own.
+  for (unsigned int col = 0; col < num_cols; col++) {
+    this->sets[col] = col;
+  }
+}
+
+void EllerRowGenerator::joinAcross(bool join_all) {
+  this->east_passages.clear();
+  for (unsigned int col = 0; col + 1 < this->num_cols; col++) {
+    const unsigned int left = this->sets[col];
+    const unsigned int right = this->sets[col + 1];
+    if (left == right || (!join_all && this->rng.below(2) == 0)) {
+      continue;
+    }
+    this->east_passages.set(col);
+    for (auto& label : this->sets) {
+      if (label == right) {
+        label = left;
+      }
+    }
+  }
+}
+
+void EllerRowGenerator::chooseDowns() {
+  this->south_passages.clear();
+  for (unsigned int col = 0; col < this->num_cols; col++) {
+    const unsigned int label = this->sets[col];
+    this->set_sizes[label] = 0;
+    this->set_downs[label] = 0;
+  }
+  for (unsigned int col = 0; col < this->num_cols; col++) {
+    const unsigned int label = this->sets[col];
+    // keep one member of each set, picked uniformly as they go by, in case
+    // none of them go down by chance.
+    if (this->rng.below(++this->set_sizes[label]) == 0) {
+      this->set_picks[label] = col;
+    }
+    if (this->rng.below(2) == 0) {
+      this->south_passages.set(col);
+      this->set_downs[label]++;
+    }
+  }
+  for (unsigned int col = 0; col < this->num_cols; col++) {
+    const unsigned int label = this->sets[col];
+    if (this->set_downs[label] == 0) {
+      this->south_passages.set(this->set_picks[label]);
+      this->set_downs[label]++;
+    }
+  }
+}
+
+void EllerRowGenerator::startNextRow() {
+  this->labels_in_use.clear();
+  for (unsigned int col = 0; col < this->num_cols; col++) {
+    if (this->south_passages.test(col)) {
+      this->labels_in_use.set(this->sets[col]);
+    }
+  }
+  // there are never more sets than columns, so a free label is always left.
+  unsigned int free_label = this->labels_in_use.findFirstUnset(0);
+  for (unsigned int col = 0; col < this->num_cols; col++) {
+    if (this->south_passages.test(col)) {
+      continue;
+    }
+    this->sets[col] = free_label;
+    this->labels_in_use.set(free_label);
+    free_label = this->labels_in_use.findFirstUnset(free_label);
+  }
+}
+
+void EllerRowGenerator::nextRow() {
+  this->joinAcross(false);
+  this->chooseDowns();
+  this->startNextRow();
+}
+
+void EllerRowGenerator::lastRow() {
+  this->joinAcross(true);
+  this->south_passages.clear();
+}
+
+size_t EllerRowGenerator::footprint() const {
+  return storageFootprint(this->sets) + this->east_passages.footprint() +
+         this->south_passages.footprint() + storageFootprint(this->set_sizes) +
+         storageFootprint(this->set_downs) + storageFootprint(this->set_picks) +
+         this->labels_in_use.footprint();
+}
@@ -0,0 +1,66 @@
+#ifndef ELLER_H
+#define ELLER_H
+#include <cstddef>
+#include <vector>
+
+#include "packed-bitset.h"
+#include "rng.h"
+
+/* EllerRowGenerator Overview
+ *
+ * Eller's algorithm generates a perfect maze one row at a time, and only
+ * ever needs to know which set each cell of the current row belongs to,
+ * where a set is the cells already joined to each other by passages. Rows
+ * can be produced forever in memory proportional to the width.
+ *
+ * Producing a row:
+ *
+ *   1. neighboring cells of different sets are joined at random, merging
+ *      their sets. (east passages)
+ *   2. every set gets at least one passage down into the next row, other
+ *      cells get one at random. (south passages)
+ *   3. cells of the next row below a south passage keep the set above
+ *      them, the rest start sets of their own.
+ *
+ * The last row joins every pair of neighbors still in different sets and
+ * has no south passages, which closes the maze off.
+ *
+ * Set labels are recycled, so they never grow past the number of columns.
+ * Merging relabels the row, so a row costs at most O(width^2), and never
+ * depends on how many rows came before it.
+ * */
+class EllerRowGenerator {
+  unsigned int num_cols;
+  Rng rng;
+  // set label of each cell of the current row.
+  std::vector<unsigned int> sets;
+  // passages of the row last produced.
+  PackedBitset east_passages;
+  PackedBitset south_passages;
+  // per label scratch space, allocated once.
+  std::vector<unsigned int> set_sizes;
+  std::vector<unsigned int> set_downs;
+  std::vector<unsigned int> set_picks;
+  PackedBitset labels_in_use;
+
+  void joinAcross(bool join_all);
+  void chooseDowns();
+  void startNextRow();
+
+ public:
+  EllerRowGenerator(unsigned int num_cols, Rng rng);
+
+  // produce the next row of the maze.
+  void nextRow();
+  // produce a row which closes the maze off, no more rows can follow.
+  void lastRow();
+  // passages of the row last produced, toward the next column and row.
+  bool east(unsigned int col) const { return this->east_passages.test(col); }
+  bool south(unsigned int col) const {
+    return this->south_passages.test(col);
+  }
+  unsigned int numCols() const { return this->num_cols; }
+  // bytes allocated by the generator, which never changes once created.
+  size_t footprint() const;
+};
+#endif
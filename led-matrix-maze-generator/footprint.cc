@@ -0,0 +1,57 @@
+#include "footprint.h"
+
+#include <algorithm>
+
+size_t GridFootprint::total() const {
+  return this->connections + this->cells + this->journal;
+}
+
+GridFootprint& GridFootprint::operator+=(const GridFootprint& other) {
+  this->connections += other.connections;
+  this->cells += other.cells;
+  this->journal += other.journal;
+  return *this;
+}
+
+void GridFootprint::raiseTo(const GridFootprint& other) {
+  this->connections = std::max(this->connections, other.connections);
+  this->cells = std::max(this->cells, other.cells);
+  this->journal = std::max(this->journal, other.journal);
+}
+
+size_t MazeFootprint::total() const {
+  return this->grid.total() + this->pixel_map + this->pixels_to_update +
+         this->modified_buffers;
+}
+
+MazeFootprint& MazeFootprint::operator+=(const MazeFootprint& other) {
+  this->grid += other.grid;
+  this->pixel_map += other.pixel_map;
+  this->pixels_to_update += other.pixels_to_update;
+  this->modified_buffers += other.modified_buffers;
+  return *this;
+}
+
+void MazeFootprint::raiseTo(const MazeFootprint& other) {
+  this->grid.raiseTo(other.grid);
+  this->pixel_map = std::max(this->pixel_map, other.pixel_map);
+  this->pixels_to_update =
+      std::max(this->pixels_to_update, other.pixels_to_update);
+  this->modified_buffers =
+      std::max(this->modified_buffers, other.modified_buffers);
+}
+
+std::ostream& operator<<(std::ostream& out, const GridFootprint& f) {
+  out << "  connections:      " << f.connections << " bytes\n"
+      << "  cells:            " << f.cells << " bytes\n"
+      << "  journal:          " << f.journal << " bytes\n";
+  return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const MazeFootprint& f) {
+  out << f.grid << "  pixel map:        " << f.pixel_map << " bytes\n"
+      << "  pixels to update: " << f.pixels_to_update << " bytes\n"
+      << "  modified buffers: " << f.modified_buffers << " bytes\n"
+      << "  total:            " << f.total() << " bytes\n";
+  return out;
+}
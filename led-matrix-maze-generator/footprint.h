@@ -0,0 +1,65 @@
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/* Footprint Overview
+ *
+ * Grids and mazes can report how many bytes each part of their state takes,
+ * so panel sizes can be checked against the memory of the board before
+ * they are tried, and regressions show up as numbers rather than as the
+ * out of memory killer.
+ *
+ * Sizes count what is allocated (a vector's capacity, not its size), since
+ * that is what the board has to provide. Fixed size members that live
+ * inside the objects themselves are included.
+ * */
+
+// bytes held by a Grid.
+struct GridFootprint {
+  // connectable and connected masks, and the neighbor offset table.
+  size_t connections = 0;
+  // per cell data.
+  size_t cells = 0;
+  // dirty bits and recorded changes of the change journal.
+  size_t journal = 0;
+
+  size_t total() const;
+  GridFootprint& operator+=(const GridFootprint&);
+  // keep the larger of each part.
+  void raiseTo(const GridFootprint&);
+};
+
+// bytes held by a Maze, including its Grid.
+struct MazeFootprint {
+  GridFootprint grid;
+  // the full pixel map of the canvas.
+  size_t pixel_map = 0;
+  // pixels waiting to be drawn.
+  size_t pixels_to_update = 0;
+  // buffers the grid's changes are drained into.
+  size_t modified_buffers = 0;
+
+  size_t total() const;
+  MazeFootprint& operator+=(const MazeFootprint&);
+  void raiseTo(const MazeFootprint&);
+};
+
+std::ostream& operator<<(std::ostream&, const GridFootprint&);
+std::ostream& operator<<(std::ostream&, const MazeFootprint&);
+
+// bytes allocated for the elements of an array of either kind of storage.
+template <class U>
+size_t storageFootprint(const std::vector<U>& v) {
+  return v.capacity() * sizeof(U);
+}
+inline size_t storageFootprint(const std::vector<bool>& v) {
+  return v.capacity() / 8;
+}
+template <class U, size_t N>
+size_t storageFootprint(const std::array<U, N>&) {
+  return N * sizeof(U);
+}
+#endif
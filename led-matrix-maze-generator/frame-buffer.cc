@@ -0,0 +1,23 @@
+#include "frame-buffer.h"
+
+#include "footprint.h"
+
+FrameBuffer::FrameBuffer(unsigned int height, unsigned int width, Pixel fill)
+    : h(height), w(width), bytes(height * width * bytes_per_pixel) {
+  this->fill(fill);
+}
+
+void FrameBuffer::fill(Pixel pixel) {
+  for (unsigned int i = 0; i < this->bytes.size(); i += bytes_per_pixel) {
+    this->bytes[i] = std::get<0>(pixel);
+    this->bytes[i + 1] = std::get<1>(pixel);
+    this->bytes[i + 2] = std::get<2>(pixel);
+  }
+}
+
+bool FrameBuffer::operator==(const FrameBuffer& other) const {
+  return this->h == other.h && this->w == other.w &&
+         this->bytes == other.bytes;
+}
+
+size_t FrameBuffer::footprint() const { return storageFootprint(this->bytes); }
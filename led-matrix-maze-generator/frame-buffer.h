@@ -0,0 +1,101 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+/* FrameBuffer Overview
+ *
+ * The pixels of a canvas kept in one contiguous block, row after row, three
+ * bytes per pixel:
+ *
+ *   r g b | r g b | ... width pixels of row 0 ... | r g b | ... row 1 ...
+ *
+ * so a whole frame is a single allocation of 3 bytes per pixel, a pixel is
+ * found with a multiply and an add, and walking the frame in row order
+ * walks memory in order. Pixels are read and written as (r, g, b) tuples of
+ * channels from 0 to 255.
+ *
+ * frame[row] gives a view of a row and frame[row][col] a pixel, and the
+ * rows can be walked with a range for, so a frame reads like the nested
+ * rows of pixels it replaced.
+ * */
+class FrameBuffer {
+ public:
+  using Pixel = std::tuple<unsigned int, unsigned int, unsigned int>;
+  static const unsigned int bytes_per_pixel = 3;
+
+  // a read only view of one row.
+  class RowView {
+    const uint8_t* pixels;
+    unsigned int w;
+
+   public:
+    RowView(const uint8_t* pixels, unsigned int width)
+        : pixels(pixels), w(width){};
+    unsigned int size() const { return this->w; }
+    Pixel operator[](unsigned int col) const {
+      const uint8_t* p = this->pixels + col * bytes_per_pixel;
+      return Pixel(p[0], p[1], p[2]);
+    }
+  };
+
+  // walks the rows in order.
+  class RowIterator {
+    const FrameBuffer* frame;
+    unsigned int row;
+
+   public:
+    RowIterator(const FrameBuffer* frame, unsigned int row)
+        : frame(frame), row(row){};
+    RowView operator*() const { return (*this->frame)[this->row]; }
+    RowIterator& operator++() {
+      this->row++;
+      return *this;
+    }
+    bool operator!=(const RowIterator& other) const {
+      return this->row != other.row;
+    }
+  };
+
+ private:
+  unsigned int h;
+  unsigned int w;
+  std::vector<uint8_t> bytes;
+
+ public:
+  FrameBuffer(unsigned int height, unsigned int width, Pixel fill);
+
+  unsigned int height() const { return this->h; }
+  unsigned int width() const { return this->w; }
+  // the number of rows, as the nested rows had it.
+  unsigned int size() const { return this->h; }
+  Pixel get(unsigned int row, unsigned int col) const {
+    return (*this)[row][col];
+  }
+  void set(unsigned int row, unsigned int col, Pixel pixel) {
+    uint8_t* p = &this->bytes[(row * this->w + col) * bytes_per_pixel];
+    p[0] = std::get<0>(pixel);
+    p[1] = std::get<1>(pixel);
+    p[2] = std::get<2>(pixel);
+  }
+  // set every pixel.
+  void fill(Pixel);
+  RowView operator[](unsigned int row) const {
+    return RowView(&this->bytes[row * this->w * bytes_per_pixel], this->w);
+  }
+  RowIterator begin() const { return RowIterator(this, 0); }
+  RowIterator end() const { return RowIterator(this, this->h); }
+  // the packed pixels, row after row.
+  const uint8_t* data() const { return this->bytes.data(); }
+  // the packed bytes of one pixel, followed by the rest of its row.
+  const uint8_t* pixelBytes(unsigned int row, unsigned int col) const {
+    return &this->bytes[(row * this->w + col) * bytes_per_pixel];
+  }
+  bool operator==(const FrameBuffer&) const;
+  bool operator!=(const FrameBuffer& other) const { return !(*this == other); }
+  // bytes allocated for the pixels.
+  size_t footprint() const;
+};
+#endif
@@ -0,0 +1,44 @@
+#include "frontier-index.h"
+
+#include "footprint.h"
+
+void FrontierIndex::insert(unsigned int id) {
+  if (this->members.test(id)) {
+    return;
+  }
+  this->members.set(id);
+  this->position[id] = this->dense.size();
+  this->dense.push_back(id);
+  if (id < this->cursor) {
+    this->cursor = id;
+  }
+}
+
+void FrontierIndex::remove(unsigned int id) {
+  if (!this->members.test(id)) {
+    return;
+  }
+  this->members.reset(id);
+  // fill the hole with the last member.
+  const unsigned int last = this->dense.back();
+  this->dense[this->position[id]] = last;
+  this->position[last] = this->position[id];
+  this->dense.pop_back();
+}
+
+unsigned int FrontierIndex::lowest() {
+  // nothing below the cursor is a member, see the overview.
+  this->cursor = this->members.findFirstSet(this->cursor);
+  return this->cursor;
+}
+
+void FrontierIndex::clear() {
+  this->members.clear();
+  this->dense.clear();
+  this->cursor = this->members.size();
+}
+
+size_t FrontierIndex::footprint() const {
+  return this->members.footprint() + storageFootprint(this->dense) +
+         storageFootprint(this->position);
+}
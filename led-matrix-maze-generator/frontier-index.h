@@ -0,0 +1,55 @@
+#ifndef FRONTIER_INDEX_H
+#define FRONTIER_INDEX_H
+#include <cstddef>
+#include <vector>
+
+#include "packed-bitset.h"
+
+/* FrontierIndex Overview
+ *
+ * The frontier of a maze being generated is the set of unvisited cells that
+ * border a visited cell, which are exactly the cells a hunt can pick. The
+ * index is kept up to date as cells are visited, so a hunt never has to
+ * scan the grid for one.
+ *
+ * Members are kept two ways, so adding, removing and picking at random are
+ * constant time:
+ *
+ *   members     a bit per cell, for membership and for finding the lowest
+ *               id in the frontier a word at a time.
+ *   dense       the members in no particular order, for picking one at
+ *               random. position holds each member's index in dense, so a
+ *               member is removed by moving the last member into its place.
+ *
+ * lowest() resumes from a cursor below which there are no members. The
+ * cursor only moves back when a lower cell joins the frontier, so a scan for
+ * the lowest member usually picks up where the last one stopped, and skips
+ * 64 cells at a time when it has to move.
+ * */
+class FrontierIndex {
+  PackedBitset members;
+  std::vector<unsigned int> dense;
+  std::vector<unsigned int> position;
+  unsigned int cursor;
+
+ public:
+  FrontierIndex(unsigned int num_cells)
+      : members(num_cells), position(num_cells, 0), cursor(num_cells) {
+    this->dense.reserve(num_cells);
+  };
+
+  bool contains(unsigned int id) const { return this->members.test(id); }
+  unsigned int size() const { return this->dense.size(); }
+  bool empty() const { return this->dense.empty(); }
+  // the member at index i of the dense list, for picking one at random.
+  unsigned int at(unsigned int i) const { return this->dense.at(i); }
+  // add or remove a cell, doing nothing if it is already in or out.
+  void insert(unsigned int id);
+  void remove(unsigned int id);
+  // the lowest id in the frontier, the number of cells if it is empty.
+  unsigned int lowest();
+  void clear();
+  // bytes allocated for the index.
+  size_t footprint() const;
+};
+#endif
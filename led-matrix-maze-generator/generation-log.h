@@ -0,0 +1,79 @@
+#ifndef GENERATION_LOG_H
+#define GENERATION_LOG_H
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "cell.h"
+#include "footprint.h"
+#include "grid.h"
+#include "rng.h"
+#include "step-result.h"
+
+/* GenerationLog Overview
+ *
+ * A recording of a maze being generated, a step at a time, which can be
+ * played back onto another grid of the same size without running the
+ * strategy again. Recording runs a strategy to completion on a grid of its
+ * own, usually on a background thread (see maze-producer.h), and drains the
+ * grid's change journal after every step into flat lists:
+ *
+ *   connections  each connection a step modified, and its status once the
+ *                step was done.
+ *   cells        each cell a step modified, and its value once the step was
+ *                done.
+ *   steps        the result of each step, and where its changes end in the
+ *                lists above.
+ *
+ * Step 0 holds whatever the strategy did to the grid when it was created,
+ * such as visiting its starting cell. Replaying every step in order leaves
+ * a grid just as the strategy left its own, and the results handed back
+ * are the ones the strategy gave, delays and all.
+ * */
+template <class T = Cell>
+class GenerationLog {
+ public:
+  using Connection = std::tuple<unsigned int, unsigned int>;
+  struct LoggedStep {
+    StepResult result;
+    // one past the last change of the step in each list.
+    unsigned int connections_end;
+    unsigned int cells_end;
+  };
+
+ private:
+  unsigned int num_rows;
+  unsigned int num_cols;
+  std::vector<Connection> connections;
+  std::vector<ConnectionStatus> statuses;
+  std::vector<unsigned int> cell_ids;
+  std::vector<T> cell_values;
+  std::vector<LoggedStep> steps;
+  // move what the grid journaled since the last step into the log.
+  template <class D, class Topo>
+  void closeStep(Grid<T, D, Topo>*, StepResult, std::vector<unsigned int>&,
+                 std::vector<Connection>&);
+
+ public:
+  GenerationLog(unsigned int num_rows, unsigned int num_cols)
+      : num_rows(num_rows), num_cols(num_cols){};
+
+  // reset g, then record Strategy generating a maze on it from start to
+  // finish. Strategy is a generation strategy template taking the grid and
+  // an Rng, such as HuntAndKillStrategy.
+  template <template <class, class, class> class Strategy, class D,
+            class Topo>
+  static GenerationLog record(Grid<T, D, Topo>* g, Rng rng);
+
+  unsigned int numRows() const { return this->num_rows; }
+  unsigned int numCols() const { return this->num_cols; }
+  // number of steps recorded, including step 0.
+  unsigned int numSteps() const { return this->steps.size(); }
+  // apply the changes of step i to g, and give back the step's result.
+  template <class D, class Topo>
+  StepResult replayStep(unsigned int i, Grid<T, D, Topo>* g) const;
+  // bytes allocated for the recording.
+  size_t footprint() const;
+};
+#include "generation-log_impl.h"
+#endif
@@ -0,0 +1,75 @@
+template <class T>
+template <class D, class Topo>
+void GenerationLog<T>::closeStep(
+    Grid<T, D, Topo>* g, StepResult result,
+    std::vector<unsigned int>& modified_cells,
+    std::vector<Connection>& modified_connections) {
+  g->drainRecentlyModifiedConnections(modified_connections);
+  for (auto& conn : modified_connections) {
+    const auto [id_a, id_b] = conn;
+    this->connections.push_back(conn);
+    this->statuses.push_back(g->queryConnection(id_a, id_b));
+  }
+  g->drainRecentlyModifiedCells(modified_cells);
+  for (auto& id : modified_cells) {
+    this->cell_ids.push_back(id);
+    this->cell_values.push_back(g->getCell(id));
+  }
+  this->steps.push_back(LoggedStep{
+      result, static_cast<unsigned int>(this->connections.size()),
+      static_cast<unsigned int>(this->cell_ids.size())});
+}
+
+template <class T>
+template <template <class, class, class> class Strategy, class D, class Topo>
+GenerationLog<T> GenerationLog<T>::record(Grid<T, D, Topo>* g, Rng rng) {
+  GenerationLog<T> log(g->num_rows, g->num_cols);
+  // drained into once per step, kept for the whole recording.
+  std::vector<unsigned int> modified_cells;
+  std::vector<Connection> modified_connections;
+
+  g->reset();
+  Strategy<T, D, Topo> strategy(g, rng);
+  log.closeStep(g, StepResult{STEP_CONTINUE, 0}, modified_cells,
+                modified_connections);
+  StepResult result;
+  do {
+    result = strategy.step();
+    log.closeStep(g, result, modified_cells, modified_connections);
+  } while (result.status != STEP_COMPLETE);
+  // the log is kept around until replayed, don't hold on to the slack.
+  log.connections.shrink_to_fit();
+  log.statuses.shrink_to_fit();
+  log.cell_ids.shrink_to_fit();
+  log.cell_values.shrink_to_fit();
+  log.steps.shrink_to_fit();
+  return log;
+}
+
+template <class T>
+template <class D, class Topo>
+StepResult GenerationLog<T>::replayStep(unsigned int i,
+                                        Grid<T, D, Topo>* g) const {
+  const unsigned int connections_begin =
+      i == 0 ? 0 : this->steps.at(i - 1).connections_end;
+  const unsigned int cells_begin = i == 0 ? 0 : this->steps.at(i - 1).cells_end;
+  const LoggedStep& logged = this->steps.at(i);
+  for (unsigned int c = connections_begin; c < logged.connections_end; c++) {
+    const auto [id_a, id_b] = this->connections[c];
+    // a passage opened and closed again within a step was logged unchanged.
+    if (g->queryConnection(id_a, id_b) != this->statuses[c]) {
+      g->modifyConnection(id_a, id_b, this->statuses[c]);
+    }
+  }
+  for (unsigned int c = cells_begin; c < logged.cells_end; c++) {
+    g->setCell(this->cell_ids[c], this->cell_values[c]);
+  }
+  return logged.result;
+}
+
+template <class T>
+size_t GenerationLog<T>::footprint() const {
+  return storageFootprint(this->connections) +
+         storageFootprint(this->statuses) + storageFootprint(this->cell_ids) +
+         storageFootprint(this->cell_values) + storageFootprint(this->steps);
+}
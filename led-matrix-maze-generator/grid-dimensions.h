@@ -0,0 +1,72 @@
+#ifndef GRID_DIMENSIONS_H
+#define GRID_DIMENSIONS_H
+#include <array>
+#include <vector>
+
+// Dimension policies decide how a Grid knows its size, and what kind of
+// storage it keeps one entry per cell in.
+//
+// DynamicDimensions is sized at runtime, for panels whose size comes from
+// the command line. Storage is heap allocated.
+struct DynamicDimensions {
+  unsigned int num_rows;
+  unsigned int num_cols;
+  unsigned int num_cells;
+
+  template <class U>
+  using Array = std::vector<U>;
+
+  DynamicDimensions(unsigned int num_rows, unsigned int num_cols)
+      : num_rows(num_rows),
+        num_cols(num_cols),
+        num_cells(num_rows * num_cols){};
+
+  // create per cell storage with every entry set to fill.
+  template <class U>
+  Array<U> makeArray(U fill) const {
+    return Array<U>(this->num_cells, fill);
+  }
+};
+
+// StaticDimensions is sized at compile time, for the fixed panel sizes most
+// deployments use. Every conversion between ids, rows and columns divides
+// by a constant, which the compiler turns into shifts and masks for power of
+// two widths instead of calling a software divide on ARMv6.
+//
+// Storage made through Array and makeArray, the connection masks and the
+// cells of a generic CellStore, is a fixed size array held inside the Grid.
+// The packed flag bitsets of CellStore<Cell> and the ChangeJournal are still
+// sized at construction and heap allocated, once, whichever policy is used.
+template <unsigned int Rows, unsigned int Cols>
+struct StaticDimensions {
+  static constexpr unsigned int num_rows = Rows;
+  static constexpr unsigned int num_cols = Cols;
+  static constexpr unsigned int num_cells = Rows * Cols;
+
+  template <class U>
+  using Array = std::array<U, Rows * Cols>;
+
+  StaticDimensions(){};
+  // accepts the runtime sizes for interchangeability with
+  // DynamicDimensions, they must match the compile time ones.
+  StaticDimensions(unsigned int num_rows, unsigned int num_cols) {
+    if (num_rows != Rows || num_cols != Cols) {
+      throw "Attempted to size a static grid differently than its type.";
+    }
+  };
+
+  template <class U>
+  Array<U> makeArray(U fill) const {
+    Array<U> array;
+    array.fill(fill);
+    return array;
+  }
+};
+
+template <unsigned int Rows, unsigned int Cols>
+constexpr unsigned int StaticDimensions<Rows, Cols>::num_rows;
+template <unsigned int Rows, unsigned int Cols>
+constexpr unsigned int StaticDimensions<Rows, Cols>::num_cols;
+template <unsigned int Rows, unsigned int Cols>
+constexpr unsigned int StaticDimensions<Rows, Cols>::num_cells;
+#endif
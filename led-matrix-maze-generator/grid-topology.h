@@ -0,0 +1,50 @@
+#ifndef GRID_TOPOLOGY_H
+#define GRID_TOPOLOGY_H
+
+// The most neighbors any topology gives a cell, which bounds the size of a
+// cell's neighbor masks and of a NeighborList.
+#define MAX_DIRECTIONS 8
+
+// Topology policies decide which cells of a Grid neighbor each other. Each
+// one is a table of {row, column} offsets to the neighbor in each
+// direction, with one table per row parity for layouts where odd rows are
+// shifted.
+//
+// Directions in every table are ordered so that walking them visits
+// neighbors in ascending id order, and so that the opposite of direction d
+// is always (num_directions - 1 - d).
+
+// OrthogonalTopology connects each cell to the cells above, below, left and
+// right of it. Its directions are the ones named by the Direction enum.
+struct OrthogonalTopology {
+  static constexpr unsigned int num_directions = 4;
+  static constexpr unsigned int num_parities = 1;
+  static constexpr int offsets[num_parities][num_directions][2] = {
+      {{-1, 0}, {0, -1}, {0, 1}, {1, 0}}};
+  static unsigned int getParity(unsigned int row) { return 0; }
+};
+
+// DiagonalTopology also connects each cell to the four cells diagonal from
+// it.
+struct DiagonalTopology {
+  static constexpr unsigned int num_directions = 8;
+  static constexpr unsigned int num_parities = 1;
+  static constexpr int offsets[num_parities][num_directions][2] = {
+      {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}}};
+  static unsigned int getParity(unsigned int row) { return 0; }
+};
+
+// HexTopology lays cells out as hexagons with odd rows shifted half a cell
+// to the right, so each cell has two neighbors in the row below, two in its
+// own row and two in the row above.
+struct HexTopology {
+  static constexpr unsigned int num_directions = 6;
+  static constexpr unsigned int num_parities = 2;
+  static constexpr int offsets[num_parities][num_directions][2] = {
+      // even rows
+      {{-1, -1}, {-1, 0}, {0, -1}, {0, 1}, {1, -1}, {1, 0}},
+      // odd rows
+      {{-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, 0}, {1, 1}}};
+  static unsigned int getParity(unsigned int row) { return row & 1; }
+};
+#endif
@@ -1,8 +1,20 @@
 #ifndef GRID_H
 #define GRID_H
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <ostream>
 #include <tuple>
 #include <vector>
 
+#include "cell-store.h"
+#include "change-journal.h"
+#include "checkpoint.h"
+#include "footprint.h"
+#include "grid-dimensions.h"
+#include "grid-topology.h"
+
 // ConnectionStatus variables are entries in the Grid's adjacency matrix.
 enum ConnectionStatus {
   NOT_CONNECTABLE,  // The two cells are not adjacent and cannot be connected.
@@ -11,6 +23,55 @@ enum ConnectionStatus {
   CONNECTION_STATUS_ERR  // An error has occurred if this is used.
 };
 
+// Direction variables name the directions of OrthogonalTopology, which index
+// the bits of each cell's neighbor masks. They are ordered so that walking
+// them visits neighbors in ascending id order, and so that the opposite of
+// direction d is always (NUM_DIRECTIONS - 1 - d).
+enum Direction {
+  DOWN,           // The neighbor in the row beneath, id - num_cols.
+  LEFT,           // The neighbor in the column to the left, id - 1.
+  RIGHT,          // The neighbor in the column to the right, id + 1.
+  UP,             // The neighbor in the row above, id + num_cols.
+  NUM_DIRECTIONS  // Not a direction, used to signal "no neighbor".
+};
+
+// MutationStatus variables report the outcome of a batch of connection
+// modifications, in place of the exceptions thrown by modifyConnection.
+enum MutationStatus {
+  MUTATION_OK,               // Every modification was applied.
+  MUTATION_NOT_ALLOWED,      // The status is not allowed for external use.
+  MUTATION_NOT_CONNECTABLE,  // A pair to connect is not connectable.
+  MUTATION_NOT_CONNECTED     // A pair to disconnect is not connected.
+};
+
+// ValidationMode variables decide whether a batch of connection
+// modifications is checked before it is applied.
+enum ValidationMode {
+  VALIDATE,  // Check every pair first, apply none of them if any fail.
+  TRUSTED    // The caller guarantees the pairs are valid, skip the checks.
+};
+
+// MutationResult is returned from a batch of connection modifications.
+struct MutationResult {
+  MutationStatus status;
+  // index of the first pair that failed, or the number of pairs applied.
+  unsigned int index;
+};
+
+// NeighborList is a fixed capacity list of cell ids, one slot per direction
+// of the largest topology, small enough to live on the stack so that
+// enumerating the neighbors of a cell never allocates.
+struct NeighborList {
+  unsigned int ids[MAX_DIRECTIONS];
+  unsigned int count = 0;
+  void push_back(unsigned int id) { ids[count++] = id; }
+  unsigned int size() const { return count; }
+  unsigned int at(unsigned int i) const { return ids[i]; }
+  unsigned int operator[](unsigned int i) const { return ids[i]; }
+  const unsigned int* begin() const { return ids; }
+  const unsigned int* end() const { return ids + count; }
+};
+
 /* Grid Overview
  *
  * A grid is defined with a number of rows and a number of columns,
@@ -19,6 +80,10 @@ enum ConnectionStatus {
  * num_rows is the number of rows in the grid.
  * num_cols is the number of columns in the grid.
  *
+ * These are provided by the Dims policy, either at runtime
+ * (DynamicDimensions) or at compile time (StaticDimensions), see
+ * grid-dimensions.h.
+ *
  *
  * A grid is constructed from bottom left to top right.
  * For Example, a grid with 4 rows and 4 columns.
@@ -45,72 +110,108 @@ enum ConnectionStatus {
  *   id and num_cols.
  *   cell 5 col = 5%4 = 1
  *
- * Each of these cells is then tracked in a modified adjacency matrix
- * which utilizes the enumerated type above rather than a traditional
- * boolean type in order to maintain more state information.
+ * The connections between cells are conceptually an NxN adjacency matrix
+ * where N is the number of cells, using the enumerated type above rather
+ * than a traditional boolean type in order to maintain more state
+ * information. Since a cell can only ever be adjacent to a handful of
+ * neighbors, almost every entry of that matrix would be NOT_CONNECTABLE, so
+ * only the row for each cell's neighbors is stored, as two bit masks indexed
+ * by the directions of the Topology policy (see grid-topology.h).
  *
- * The adjacency matrix is an NxN matrix where N is the number of cells.
- * Like this:
+ *   connectable[id] has bit d set when the cell has a neighbor in direction d.
+ *   connected[id]   has bit d set when the passage in direction d is open.
+ *
+ * For example, with the default OrthogonalTopology cell 0 above has
+ * neighbors UP (4) and RIGHT (1), and cell 5 has all four neighbors.
 
-                    15 | 0 0                1  0
-                    14 | 0 0                0  1
-                     . | . .      .  . .
-                     . | . .      .  . .
-                     . | . .      .  . .
-                     1 | 1 0      .  . .    0  0
-                     0 | 0 1                0  0
-                     -------------------------
-                         0 1       ...     14 15
+                         UP  RIGHT  LEFT  DOWN
+        connectable[0]    1      1     0     0
+        connectable[5]    1      1     1     1
 
- * In the example above, the entries are a numerical representation of the
- * enumerated type.
+ * A matrix entry is recovered from the masks like so:
+ *
+    NOT_CONNECTABLE   b is not a neighbor of a in any direction.
+    CONNECTABLE       b is the neighbor of a in direction d, bit d unset in
+                      connected[a].
+    CONNECTED         b is the neighbor of a in direction d, bit d set in
+                      connected[a].
+ *
+ * The id offset to the neighbor in each direction is computed from the
+ * topology once, when the grid is created. This keeps memory at two bytes
+ * per cell, and queries and modifications at a handful of table lookups no
+ * matter how large the grid grows or which topology is used.
  *
-    CANNOT_BE_CONNECTED      = 0
-    CONNECTABLE              = 1
-    CONNECTED                = 2
-    CONNECTION_STATUS_ERR    = 3
+ * A cell on the edge of the grid can also have an exit, a passage out
+ * through the edge in a direction where it has no neighbor, such as one
+ * across the seam into the grid of a neighboring panel. An exit sets bit d
+ * of connected[id] without bit d of connectable[id], so it counts toward
+ * the cell's degree and is kept by checkpoints, but it never leads to a
+ * neighbor.
  *
  * cell connections can only transition from  CONNECTABLE to CONNECTED and
  * CONNECTED TO CONNECTABLE by external entities. Attempting to transition
  * a from any other state will throw an error.
  * */
 
-template <class T>
-class Grid {
+template <class T, class Dims = DynamicDimensions,
+          class Topology = OrthogonalTopology>
+class Grid : public Dims {
  public:
   // number of rows and columns in the grid.
-  unsigned int num_rows;
-  unsigned int num_cols;
-  unsigned int num_cells;
+  using Dims::num_cells;
+  using Dims::num_cols;
+  using Dims::num_rows;
 
  private:
-  using CellListFmt = std::vector<T>;
+  using CellListFmt = CellStore<T, Dims>;
   using IdListFmt = std::vector<unsigned int>;
   using ConnectionListFmt = std::vector<std::tuple<unsigned int, unsigned int>>;
   using RowColFmt = std::tuple<unsigned int, unsigned int>;
-  using MatrixFmt = std::vector<std::vector<ConnectionStatus>>;
+  using MaskListFmt = typename Dims::template Array<uint8_t>;
 
-  // state_matrix is the adjacency matrix described above.
-  MatrixFmt state_matrix;
+  // neighbor masks described above, one entry per cell.
+  MaskListFmt connectable;
+  MaskListFmt connected;
+  // id offset from a cell to its neighbor in each direction, per row parity.
+  int offsets[Topology::num_parities][Topology::num_directions];
+  // number of cells with each number of open passages, kept up to date as
+  // connections are modified.
+  unsigned int degree_counts[Topology::num_directions + 1];
+  // count every cell's degree again, after the masks were replaced.
+  void countDegrees();
   // list of cell data.
   CellListFmt cells;
-  // this is a helper function which aids in constructing the state matrix.
-  MatrixFmt createStateMatrix(unsigned int, unsigned int);
-  // list of cell ids that have been modifed since last call.
-  IdListFmt recently_modified_cells;
-  // list of connection id pairs that have been modified since last call.
-  ConnectionListFmt recently_modified_connections;
+  // this is a helper function which aids in constructing the connectable
+  // masks.
+  MaskListFmt createConnectableMasks();
+  // this is a helper function which fills in the offsets table.
+  void initOffsets();
+  // the row of the offsets table that applies to a cell.
+  const int* getOffsets(unsigned int);
+  // find the direction of id_b from id_a, num_directions if not neighbors.
+  unsigned int getDirection(unsigned int, unsigned int);
+  // validate a modification of a connection without applying it.
+  MutationStatus checkConnection(unsigned int, unsigned int, ConnectionStatus);
+  // apply a modification of the connection in direction d from id_a.
+  void applyConnection(unsigned int, unsigned int, unsigned int,
+                       ConnectionStatus);
+  // cell ids and connection id pairs that have been modifed since last call.
+  ChangeJournal journal;
 
  public:
   // A grid is created with a number of rows and columns,
-  // from which a state matrix and cells are generated.
+  // from which the neighbor masks and cells are generated.
   Grid(unsigned int num_rows, unsigned int num_cols)
-      : num_rows(num_rows),
-        num_cols(num_cols),
-        num_cells(num_rows * num_cols),
-        state_matrix(this->createStateMatrix(num_rows, num_cols)),
-        cells({CellListFmt(num_rows * num_cols, T())}),
-        recently_modified_cells(IdListFmt()){};
+      : Dims(num_rows, num_cols),
+        connectable(this->createConnectableMasks()),
+        connected(this->template makeArray<uint8_t>(0)),
+        cells(CellListFmt(*this)),
+        journal(this->num_cells, this->num_cells * Topology::num_directions) {
+    this->initOffsets();
+    this->countDegrees();
+  };
+  // A grid with compile time dimensions can also be created without them.
+  Grid() : Grid(Dims::num_rows, Dims::num_cols){};
 
   // and gives back an id.
   unsigned int getIdFromRowCol(RowColFmt);
@@ -123,18 +224,70 @@ class Grid {
   // modify the connection status of two ids
   void modifyConnection(unsigned int, unsigned int, ConnectionStatus);
   void modifyConnection(RowColFmt, RowColFmt, ConnectionStatus);
+  // modify the connection status of a range of id pairs at once. The range
+  // is validated once up front and applied in a single pass, or applied
+  // without validation in TRUSTED mode. Pairs that are not neighbors are
+  // skipped in TRUSTED mode, any other invalid pair is the caller's problem.
+  template <class Iter>
+  MutationResult modifyConnections(Iter, Iter, ConnectionStatus,
+                                   ValidationMode = VALIDATE);
+  // query, open (CONNECTED) or close (CONNECTABLE) the exit of a cell in a
+  // direction, see above. Directions with a neighbor are NOT_CONNECTABLE,
+  // and modifying one throws. The cell is journaled when its exit changes.
+  ConnectionStatus queryExit(unsigned int, unsigned int);
+  void modifyExit(unsigned int, unsigned int, ConnectionStatus);
+  // the number of open passages of a cell, exits included, a popcount of its
+  // connected mask.
+  unsigned int getDegree(unsigned int);
+  // the number of cells with exactly the given number of open passages, and
+  // the dead ends (one passage) and junctions (three or more) among them.
+  // All are kept as connections are modified, so they take constant time.
+  unsigned int countCellsWithDegree(unsigned int);
+  unsigned int countDeadEnds();
+  unsigned int countJunctions();
   // retrieve a cell.
   T getCell(unsigned int);
   T getCell(RowColFmt);
   // set a cell
   void setCell(unsigned int, T);
   void setCell(RowColFmt, T);
+  // retrieve a reference to a cell so it can be modified in place, the cell
+  // is treated as modified.
+  typename CellListFmt::reference getCellRef(unsigned int);
+  // retrieve the cell store, for the bulk queries it offers.
+  const CellListFmt& getCells();
   // get cell ids matching from target id matching ConnectionStatus
   IdListFmt getCellIdsMatching(unsigned int, ConnectionStatus);
+  // get the neighbors of the target id matching ConnectionStatus, in
+  // ascending id order. Only CONNECTABLE and CONNECTED can match a neighbor.
+  NeighborList getNeighborsMatching(unsigned int, ConnectionStatus);
   // get list of cell ids that have been modifed since last call.
   IdListFmt getRecentlyModifiedCells();
-  // get list of connections that have been modifed since last call.
+  // get list of connections that have been modifed since last call, each
+  // connection is listed once with the lower id first.
   ConnectionListFmt getRecentlyModifiedConnections();
+  // swap the modified cells or connections into the given buffer, which
+  // avoids copying or allocating when the buffer is reused between calls.
+  void drainRecentlyModifiedCells(IdListFmt&);
+  void drainRecentlyModifiedConnections(ConnectionListFmt&);
+  // view the modifications without consuming them.
+  const IdListFmt& peekRecentlyModifiedCells();
+  const ConnectionListFmt& peekRecentlyModifiedConnections();
+  // write the connections and cells to a checkpoint, or restore them from
+  // one written by a grid of the same size and topology. Restoring does not
+  // journal anything.
+  void saveState(std::ostream&);
+  void loadState(std::istream&);
+  // put every connection and cell back the way a new grid has them, in
+  // place, so the grid can be reused for another maze without allocating.
+  // Nothing is journaled, and anything journaled before is dropped.
+  void reset();
+  // bytes held by each part of the grid.
+  GridFootprint footprint();
+  // register an observer to be told of every modification as it happens.
+  // cells modified through getCellRef are reported when the reference is
+  // handed out, before the modification is made.
+  void setObserver(GridObserver*);
 };
 
 #include "grid_impl.h"
@@ -1,158 +1,411 @@
-template <class T>
-typename Grid<T>::MatrixFmt Grid<T>::createStateMatrix(unsigned int num_rows,
-                                                       unsigned int num_cols) {
-  // adjacency matrix is an NxN matrix of cell ids where N
-  // is the number of cells.
-  std::vector<std::vector<ConnectionStatus>> matrix(
-      this->num_cells,
-      std::vector<ConnectionStatus>(this->num_cells, NOT_CONNECTABLE));
-
-  // begin the process of marking neighboring cells as connectable
+template <class T, class D, class Topo>
+typename Grid<T, D, Topo>::MaskListFmt
+Grid<T, D, Topo>::createConnectableMasks() {
+  // one mask per cell, no cell starts out with any neighbors.
+  MaskListFmt masks = this->template makeArray<uint8_t>(0);
+
+  // begin the process of marking neighboring cells as connectable, a cell
+  // has a neighbor in each direction whose offset stays inside the grid.
   for (unsigned int id = 0; id < this->num_cells; id++) {
     auto [current_row, current_col] = getRowColFromId(id);
-
-    // row is above 0, so it has a neighbor beneath it.
-    if (current_row > 0) {
-      RowColFmt down_row_col = std::make_tuple<unsigned int, unsigned int>(
-          current_row - 1, std::move(current_col));
-      unsigned int id_down = getIdFromRowCol(down_row_col);
-      matrix[id][id_down] = CONNECTABLE;
-      matrix[id_down][id] = CONNECTABLE;
+    unsigned int parity = Topo::getParity(current_row);
+    for (unsigned int d = 0; d < Topo::num_directions; d++) {
+      int row = static_cast<int>(current_row) + Topo::offsets[parity][d][0];
+      int col = static_cast<int>(current_col) + Topo::offsets[parity][d][1];
+      if (row >= 0 && row < static_cast<int>(this->num_rows) && col >= 0 &&
+          col < static_cast<int>(this->num_cols)) {
+        masks[id] |= 1 << d;
+      }
     }
+  }
+  return masks;
+}
 
-    // column is above 0, so it has a neighbor to the left of it.
-    if (current_col > 0) {
-      RowColFmt left_row_col = std::make_tuple<unsigned int, unsigned int>(
-          std::move(current_row), current_col - 1);
-      unsigned int id_left = getIdFromRowCol(left_row_col);
-      matrix[id][id_left] = CONNECTABLE;
-      matrix[id_left][id] = CONNECTABLE;
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::initOffsets() {
+  // turn the topology's row and column offsets into id offsets, once.
+  for (unsigned int parity = 0; parity < Topo::num_parities; parity++) {
+    for (unsigned int d = 0; d < Topo::num_directions; d++) {
+      this->offsets[parity][d] =
+          Topo::offsets[parity][d][0] * static_cast<int>(this->num_cols) +
+          Topo::offsets[parity][d][1];
     }
+  }
+}
 
-    // row is less than max addressable row (num_rows-1),
-    // so it has a neighbor above it.
-    if (current_row < num_rows - 1) {
-      RowColFmt up_row_col = std::make_tuple<unsigned int, unsigned int>(
-          current_row + 1, std::move(current_col));
-      unsigned int id_up = getIdFromRowCol(up_row_col);
-      matrix[id][id_up] = CONNECTABLE;
-      matrix[id_up][id] = CONNECTABLE;
-    }
+template <class T, class D, class Topo>
+const int* Grid<T, D, Topo>::getOffsets(unsigned int id) {
+  if (Topo::num_parities == 1) {
+    return this->offsets[0];
+  }
+  return this->offsets[Topo::getParity(id / this->num_cols)];
+}
 
-    // col is less than max addressable column (num_cols-1),
-    // so it has a neighbor to the right of it.
-    if (current_col < num_cols - 1) {
-      RowColFmt right_row_col = std::make_tuple<unsigned int, unsigned int>(
-          std::move(current_row), current_col + 1);
-      unsigned int id_right = getIdFromRowCol(right_row_col);
-      matrix[id][id_right] = CONNECTABLE;
-      matrix[id_right][id] = CONNECTABLE;
+template <class T, class D, class Topo>
+unsigned int Grid<T, D, Topo>::getDirection(unsigned int id_a,
+                                            unsigned int id_b) {
+  // only directions with a neighbor are considered, so the offset can never
+  // step off the edge of the grid or wrap around to another row.
+  const int* offsets = getOffsets(id_a);
+  for (unsigned int d = 0; d < Topo::num_directions; d++) {
+    if ((this->connectable[id_a] & (1 << d)) && id_a + offsets[d] == id_b) {
+      return d;
     }
   }
-  return matrix;
+  return Topo::num_directions;
 }
 
-template <class T>
-unsigned int Grid<T>::getIdFromRowCol(Grid::RowColFmt row_col) {
+template <class T, class D, class Topo>
+unsigned int Grid<T, D, Topo>::getIdFromRowCol(Grid::RowColFmt row_col) {
   auto [row, col] = row_col;
   return (row * this->num_cols) + col;
 };
 
-template <class T>
-typename Grid<T>::RowColFmt Grid<T>::getRowColFromId(unsigned int id) {
-  auto getRowFromId = [&](unsigned int id) { return id / num_cols; };
-  auto getColFromId = [&](unsigned int id) { return id % num_cols; };
+template <class T, class D, class Topo>
+typename Grid<T, D, Topo>::RowColFmt Grid<T, D, Topo>::getRowColFromId(
+    unsigned int id) {
+  auto getRowFromId = [&](unsigned int id) { return id / this->num_cols; };
+  auto getColFromId = [&](unsigned int id) { return id % this->num_cols; };
   return std::make_tuple<unsigned int, unsigned int>(getRowFromId(id),
                                                      getColFromId(id));
 };
 
-template <class T>
-ConnectionStatus Grid<T>::queryConnection(unsigned int id_a,
-                                          unsigned int id_b) {
-  return this->state_matrix[id_a][id_b];
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::countDegrees() {
+  std::fill(std::begin(this->degree_counts), std::end(this->degree_counts), 0);
+  for (unsigned int id = 0; id < this->num_cells; id++) {
+    this->degree_counts[this->getDegree(id)]++;
+  }
+}
+
+template <class T, class D, class Topo>
+unsigned int Grid<T, D, Topo>::getDegree(unsigned int id) {
+  return __builtin_popcount(this->connected[id]);
+}
+
+template <class T, class D, class Topo>
+unsigned int Grid<T, D, Topo>::countCellsWithDegree(unsigned int degree) {
+  return degree <= Topo::num_directions ? this->degree_counts[degree] : 0;
+}
+
+template <class T, class D, class Topo>
+unsigned int Grid<T, D, Topo>::countDeadEnds() {
+  return this->degree_counts[1];
+}
+
+template <class T, class D, class Topo>
+unsigned int Grid<T, D, Topo>::countJunctions() {
+  unsigned int total = 0;
+  for (unsigned int degree = 3; degree <= Topo::num_directions; degree++) {
+    total += this->degree_counts[degree];
+  }
+  return total;
 }
 
-template <class T>
-ConnectionStatus Grid<T>::queryConnection(Grid<T>::RowColFmt pair_a,
-                                          Grid<T>::RowColFmt pair_b) {
+template <class T, class D, class Topo>
+ConnectionStatus Grid<T, D, Topo>::queryConnection(unsigned int id_a,
+                                                   unsigned int id_b) {
+  unsigned int d = getDirection(id_a, id_b);
+  if (d == Topo::num_directions) {
+    return NOT_CONNECTABLE;
+  }
+  return (this->connected[id_a] & (1 << d)) ? CONNECTED : CONNECTABLE;
+}
+
+template <class T, class D, class Topo>
+ConnectionStatus Grid<T, D, Topo>::queryConnection(
+    Grid<T, D, Topo>::RowColFmt pair_a, Grid<T, D, Topo>::RowColFmt pair_b) {
   return queryConnection(getIdFromRowCol(pair_a), getIdFromRowCol(pair_b));
 }
 
-template <class T>
-void Grid<T>::modifyConnection(unsigned int id_a, unsigned int id_b,
-                               ConnectionStatus next_status) {
-  if (next_status == NOT_CONNECTABLE || next_status == CONNECTION_STATUS_ERR) {
+template <class T, class D, class Topo>
+ConnectionStatus Grid<T, D, Topo>::queryExit(unsigned int id, unsigned int d) {
+  if (d >= Topo::num_directions || (this->connectable[id] & (1 << d))) {
+    return NOT_CONNECTABLE;
+  }
+  return (this->connected[id] & (1 << d)) ? CONNECTED : CONNECTABLE;
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::modifyExit(unsigned int id, unsigned int d,
+                                  ConnectionStatus next_status) {
+  if (next_status != CONNECTED && next_status != CONNECTABLE) {
     throw "Attempted to set a status which is not allowed for external use.";
   }
-  if (this->state_matrix[id_a][id_b] != CONNECTABLE &&
-      next_status == CONNECTED) {
-    throw "Attempted to connect a non-connectable state.";
+  const ConnectionStatus current_status = this->queryExit(id, d);
+  if (current_status == NOT_CONNECTABLE) {
+    throw "Attempted to open an exit toward a neighbor.";
   }
-  if (this->state_matrix[id_a][id_b] != CONNECTED &&
-      next_status == CONNECTABLE) {
-    throw "Attempted to disconnect from a non-connected state.";
+  if (current_status == next_status) {
+    throw next_status == CONNECTED
+        ? "Attempted to connect a non-connectable state."
+        : "Attempted to disconnect from a non-connected state.";
   }
-  this->recently_modified_connections.push_back(
-      std::tuple<unsigned int, unsigned int>({id_a, id_b}));
-  this->recently_modified_connections.push_back(
-      std::tuple<unsigned int, unsigned int>({id_b, id_a}));
-  this->recently_modified_cells.push_back(id_a);
-  this->recently_modified_cells.push_back(id_b);
-  this->state_matrix[id_a][id_b] = next_status;
-  this->state_matrix[id_b][id_a] = next_status;
+  this->degree_counts[this->getDegree(id)]--;
+  this->connected[id] ^= 1 << d;
+  this->degree_counts[this->getDegree(id)]++;
+  this->journal.recordCell(id);
 }
 
-template <class T>
-void Grid<T>::modifyConnection(Grid<T>::RowColFmt pair_a,
-                               Grid<T>::RowColFmt pair_b,
-                               ConnectionStatus next_status) {
+template <class T, class D, class Topo>
+MutationStatus Grid<T, D, Topo>::checkConnection(unsigned int id_a,
+                                                 unsigned int id_b,
+                                                 ConnectionStatus next_status) {
+  if (next_status == NOT_CONNECTABLE || next_status == CONNECTION_STATUS_ERR) {
+    return MUTATION_NOT_ALLOWED;
+  }
+  ConnectionStatus current_status = queryConnection(id_a, id_b);
+  if (current_status != CONNECTABLE && next_status == CONNECTED) {
+    return MUTATION_NOT_CONNECTABLE;
+  }
+  if (current_status != CONNECTED && next_status == CONNECTABLE) {
+    return MUTATION_NOT_CONNECTED;
+  }
+  return MUTATION_OK;
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::applyConnection(unsigned int id_a, unsigned int id_b,
+                                       unsigned int d,
+                                       ConnectionStatus next_status) {
+  // the passage is open in direction d from a, and the opposite from b.
+  unsigned int opposite = Topo::num_directions - 1 - d;
+  this->degree_counts[this->getDegree(id_a)]--;
+  this->degree_counts[this->getDegree(id_b)]--;
+  if (next_status == CONNECTED) {
+    this->connected[id_a] |= 1 << d;
+    this->connected[id_b] |= 1 << opposite;
+  } else {
+    this->connected[id_a] &= ~(1 << d);
+    this->connected[id_b] &= ~(1 << opposite);
+  }
+  this->degree_counts[this->getDegree(id_a)]++;
+  this->degree_counts[this->getDegree(id_b)]++;
+  // both orderings of a pair share the slot of the lower id's direction.
+  if (id_a < id_b) {
+    this->journal.recordConnection(id_a, id_b,
+                                   id_a * Topo::num_directions + d);
+  } else {
+    this->journal.recordConnection(id_b, id_a,
+                                   id_b * Topo::num_directions + opposite);
+  }
+  this->journal.recordCell(id_a);
+  this->journal.recordCell(id_b);
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::modifyConnection(unsigned int id_a, unsigned int id_b,
+                                        ConnectionStatus next_status) {
+  switch (checkConnection(id_a, id_b, next_status)) {
+    case MUTATION_NOT_ALLOWED:
+      throw "Attempted to set a status which is not allowed for external use.";
+    case MUTATION_NOT_CONNECTABLE:
+      throw "Attempted to connect a non-connectable state.";
+    case MUTATION_NOT_CONNECTED:
+      throw "Attempted to disconnect from a non-connected state.";
+    case MUTATION_OK:
+      break;
+  }
+  applyConnection(id_a, id_b, getDirection(id_a, id_b), next_status);
+}
+
+template <class T, class D, class Topo>
+template <class Iter>
+MutationResult Grid<T, D, Topo>::modifyConnections(Iter first, Iter last,
+                                                   ConnectionStatus next_status,
+                                                   ValidationMode mode) {
+  if (mode == VALIDATE) {
+    unsigned int index = 0;
+    for (Iter pair = first; pair != last; ++pair, index++) {
+      const auto [id_a, id_b] = *pair;
+      MutationStatus status = checkConnection(id_a, id_b, next_status);
+      if (status != MUTATION_OK) {
+        return MutationResult{status, index};
+      }
+    }
+  } else if (next_status != CONNECTED && next_status != CONNECTABLE) {
+    // even trusted callers cannot corrupt the masks with these.
+    return MutationResult{MUTATION_NOT_ALLOWED, 0};
+  }
+
+  unsigned int applied = 0;
+  for (Iter pair = first; pair != last; ++pair) {
+    const auto [id_a, id_b] = *pair;
+    unsigned int d = getDirection(id_a, id_b);
+    if (d == Topo::num_directions) {
+      continue;
+    }
+    applyConnection(id_a, id_b, d, next_status);
+    applied++;
+  }
+  return MutationResult{MUTATION_OK, applied};
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::modifyConnection(Grid<T, D, Topo>::RowColFmt pair_a,
+                                        Grid<T, D, Topo>::RowColFmt pair_b,
+                                        ConnectionStatus next_status) {
   modifyConnection(getIdFromRowCol(pair_a), getIdFromRowCol(pair_b),
                    next_status);
 }
 
-template <class T>
-T Grid<T>::getCell(unsigned int id) {
-  return this->cells.at(id);
+template <class T, class D, class Topo>
+T Grid<T, D, Topo>::getCell(unsigned int id) {
+  return this->cells.get(id);
 }
 
-template <class T>
-T Grid<T>::getCell(Grid<T>::RowColFmt pair) {
+template <class T, class D, class Topo>
+T Grid<T, D, Topo>::getCell(Grid<T, D, Topo>::RowColFmt pair) {
   return getCell(getIdFromRowCol(pair));
 }
 
-template <class T>
-void Grid<T>::setCell(unsigned int id, T cell) {
-  this->recently_modified_cells.push_back(id);
-  this->cells.at(id) = cell;
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::setCell(unsigned int id, T cell) {
+  this->cells.set(id, cell);
+  this->journal.recordCell(id);
 }
 
-template <class T>
-void Grid<T>::setCell(Grid<T>::RowColFmt pair, T cell) {
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::setCell(Grid<T, D, Topo>::RowColFmt pair, T cell) {
   setCell(getIdFromRowCol(pair), cell);
 }
 
-template <class T>
-typename Grid<T>::IdListFmt Grid<T>::getCellIdsMatching(
+template <class T, class D, class Topo>
+typename Grid<T, D, Topo>::CellListFmt::reference Grid<T, D, Topo>::getCellRef(
+    unsigned int id) {
+  typename CellListFmt::reference cell = this->cells.at(id);
+  this->journal.recordCell(id);
+  return cell;
+}
+
+template <class T, class D, class Topo>
+const typename Grid<T, D, Topo>::CellListFmt& Grid<T, D, Topo>::getCells() {
+  return this->cells;
+}
+
+template <class T, class D, class Topo>
+typename Grid<T, D, Topo>::IdListFmt Grid<T, D, Topo>::getCellIdsMatching(
     unsigned int id, ConnectionStatus status) {
   std::vector<unsigned int> matching;
-  for (unsigned int i = 0; i < this->num_cells; i++) {
-    if (this->state_matrix[id][i] == status) {
-      matching.push_back(i);
+  if (status == NOT_CONNECTABLE) {
+    // everything but the neighbors matches, so there is nothing to do but
+    // check every cell.
+    for (unsigned int i = 0; i < this->num_cells; i++) {
+      if (getDirection(id, i) == Topo::num_directions) {
+        matching.push_back(i);
+      }
+    }
+    return matching;
+  }
+  auto neighbors = getNeighborsMatching(id, status);
+  return IdListFmt(neighbors.begin(), neighbors.end());
+}
+
+template <class T, class D, class Topo>
+NeighborList Grid<T, D, Topo>::getNeighborsMatching(unsigned int id,
+                                                    ConnectionStatus status) {
+  NeighborList matching;
+  if (status != CONNECTABLE && status != CONNECTED) {
+    // neighbors are always either connectable or connected.
+    return matching;
+  }
+  const int* offsets = getOffsets(id);
+  for (unsigned int d = 0; d < Topo::num_directions; d++) {
+    if (!(this->connectable[id] & (1 << d))) {
+      continue;
+    }
+    bool is_connected = this->connected[id] & (1 << d);
+    if ((status == CONNECTED) == is_connected) {
+      matching.push_back(id + offsets[d]);
     }
   }
   return matching;
 }
 
-template <class T>
-typename Grid<T>::IdListFmt Grid<T>::getRecentlyModifiedCells() {
-  auto recent = this->recently_modified_cells;
-  this->recently_modified_cells.clear();
+template <class T, class D, class Topo>
+typename Grid<T, D, Topo>::IdListFmt
+Grid<T, D, Topo>::getRecentlyModifiedCells() {
+  IdListFmt recent;
+  this->journal.drainCells(recent);
   return recent;
 }
 
-template <class T>
-typename Grid<T>::ConnectionListFmt Grid<T>::getRecentlyModifiedConnections() {
-  auto recent = this->recently_modified_connections;
-  this->recently_modified_connections.clear();
+template <class T, class D, class Topo>
+typename Grid<T, D, Topo>::ConnectionListFmt
+Grid<T, D, Topo>::getRecentlyModifiedConnections() {
+  ConnectionListFmt recent;
+  this->journal.drainConnections(recent);
   return recent;
 }
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::drainRecentlyModifiedCells(
+    Grid<T, D, Topo>::IdListFmt& out) {
+  this->journal.drainCells(out);
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::drainRecentlyModifiedConnections(
+    Grid<T, D, Topo>::ConnectionListFmt& out) {
+  this->journal.drainConnections(out);
+}
+
+template <class T, class D, class Topo>
+const typename Grid<T, D, Topo>::IdListFmt&
+Grid<T, D, Topo>::peekRecentlyModifiedCells() {
+  return this->journal.peekCells();
+}
+
+template <class T, class D, class Topo>
+const typename Grid<T, D, Topo>::ConnectionListFmt&
+Grid<T, D, Topo>::peekRecentlyModifiedConnections() {
+  return this->journal.peekConnections();
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::saveState(std::ostream& out) {
+  writeCheckpointValue<unsigned int>(out, this->num_rows);
+  writeCheckpointValue<unsigned int>(out, this->num_cols);
+  writeCheckpointValue<unsigned int>(out, Topo::num_directions);
+  writeCheckpointBytes(out, &this->connected[0], this->num_cells);
+  this->cells.saveState(out);
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::loadState(std::istream& in) {
+  expectCheckpointValue<unsigned int>(in, this->num_rows);
+  expectCheckpointValue<unsigned int>(in, this->num_cols);
+  expectCheckpointValue<unsigned int>(in, Topo::num_directions);
+  readCheckpointBytes(in, &this->connected[0], this->num_cells);
+  for (unsigned int id = 0; id < this->num_cells; id++) {
+    // never trust a passage in a direction the topology does not have,
+    // passages where there is no neighbor are exits.
+    this->connected[id] &= (1 << Topo::num_directions) - 1;
+  }
+  this->countDegrees();
+  this->cells.loadState(in);
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::reset() {
+  std::fill(this->connected.begin(), this->connected.end(), 0);
+  this->countDegrees();
+  this->cells.reset();
+  this->journal.clear();
+}
+
+template <class T, class D, class Topo>
+GridFootprint Grid<T, D, Topo>::footprint() {
+  GridFootprint f;
+  f.connections = storageFootprint(this->connectable) +
+                  storageFootprint(this->connected) + sizeof(this->offsets) +
+                  sizeof(this->degree_counts);
+  f.cells = this->cells.footprint();
+  f.journal = this->journal.footprint();
+  return f;
+}
+
+template <class T, class D, class Topo>
+void Grid<T, D, Topo>::setObserver(GridObserver* observer) {
+  this->journal.setObserver(observer);
+}
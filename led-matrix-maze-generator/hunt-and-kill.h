@@ -1,11 +1,16 @@
 #ifndef HUNT_AND_KILL_H
 #define HUNT_AND_KILL_H
 #include <exception>
-#include <random>
+#include <istream>
+#include <ostream>
 
 #include "cell.h"
+#include "checkpoint.h"
+#include "frontier-index.h"
 #include "grid.h"
 #include "maze-exceptions.h"
+#include "rng.h"
+#include "step-result.h"
 struct CantWalkException : public std::exception {
   const char* what() const throw();
 };
@@ -14,16 +19,46 @@ struct HuntFailedException : public std::exception {
   const char* what() const throw();
 };
 
-template <typename T = Cell>
+// which frontier cell a hunt picks. HUNT_ROW_CURSOR picks the lowest id, as
+// the classic row by row scan would, HUNT_RANDOM picks any of them.
+enum HuntMode { HUNT_ROW_CURSOR, HUNT_RANDOM };
+
+template <typename T = Cell, typename D = DynamicDimensions,
+          typename Topo = OrthogonalTopology>
 struct HuntAndKillStrategy {
-  Grid<T>* g;
+  Grid<T, D, Topo>* g;
+  // every random choice is drawn from here, see rng.h.
+  Rng rng;
+  HuntMode mode;
+  // unvisited cells next to a visited cell, the candidates for a hunt.
+  FrontierIndex frontier;
   unsigned int current_cell;
   unsigned int init_current_cell();
-  HuntAndKillStrategy(Grid<T>* grid)
-      : g(grid), current_cell(init_current_cell()){};
+  // mark a cell visited, and move the frontier past it.
+  void visit(unsigned int);
+  // rebuild the frontier from the visited cells of the grid.
+  void rebuildFrontier();
+  HuntAndKillStrategy(Grid<T, D, Topo>* grid, Rng r,
+                      HuntMode m = HUNT_ROW_CURSOR)
+      : g(grid),
+        rng(r),
+        mode(m),
+        frontier(grid->num_cells),
+        current_cell(init_current_cell()){};
+  // without a generator, one is seeded from the system.
+  HuntAndKillStrategy(Grid<T, D, Topo>* grid, HuntMode m = HUNT_ROW_CURSOR)
+      : HuntAndKillStrategy(grid, Rng(), m){};
+  // walk or hunt, returning false when there is nowhere to go.
+  bool tryWalk();
+  bool tryHunt();
+  // walk or hunt, throwing when there is nowhere to go.
   void walk();
   void hunt();
-  float step();
+  StepResult step();
+  // write or read the strategy's progress, and the state of its generator,
+  // to a checkpoint.
+  void saveState(std::ostream&);
+  void loadState(std::istream&);
 };
 #include "hunt-and-kill_impl.h"
 #endif
@@ -1,62 +1,81 @@
-const char* CantWalkException::what() const throw() {
+inline const char* CantWalkException::what() const throw() {
   return "Cannot walk further, all connectable cells from here have been "
          "visited";
 }
 
-const char* HuntFailedException::what() const throw() {
+inline const char* HuntFailedException::what() const throw() {
   return "No cell found in the hunt, must be finished with generation.";
 }
 
-template <typename T>
-unsigned int HuntAndKillStrategy<T>::init_current_cell() {
-  unsigned int starting_cell = rand() % this->g->num_cells;
-  auto cell = this->g->getCell(starting_cell);
-  cell.visited = true;
-  this->g->setCell(starting_cell, cell);
+template <typename T, typename D, typename Topo>
+unsigned int HuntAndKillStrategy<T, D, Topo>::init_current_cell() {
+  unsigned int starting_cell = this->rng.below(this->g->num_cells);
+  this->visit(starting_cell);
   return starting_cell;
 }
 
-template <typename T>
-void HuntAndKillStrategy<T>::walk() {
-  auto not_visited_and_connectable =
-      [&](std::vector<unsigned int> connectable) {
-        std::vector<unsigned int> matching;
-        for (auto& cell : connectable) {
-          if (!this->g->getCell(cell).visited) {
-            matching.push_back(cell);
-          }
-        }
-        return matching;
-      };
-
-  auto cell = this->g->getCell(this->current_cell);
-  if (cell.emphasized) {
-    cell.emphasized = false;
-    this->g->setCell(this->current_cell, cell);
+template <typename T, typename D, typename Topo>
+void HuntAndKillStrategy<T, D, Topo>::visit(unsigned int id) {
+  this->g->getCellRef(id).visited = true;
+  this->frontier.remove(id);
+  for (auto& neighbor : this->g->getNeighborsMatching(id, CONNECTABLE)) {
+    if (!this->g->getCell(neighbor).visited) {
+      this->frontier.insert(neighbor);
+    }
+  }
+}
+
+template <typename T, typename D, typename Topo>
+void HuntAndKillStrategy<T, D, Topo>::rebuildFrontier() {
+  this->frontier.clear();
+  for (unsigned int id = 0; id < this->g->num_cells; id++) {
+    if (!this->g->getCell(id).visited) {
+      continue;
+    }
+    for (auto& neighbor : this->g->getNeighborsMatching(id, CONNECTABLE)) {
+      if (!this->g->getCell(neighbor).visited) {
+        this->frontier.insert(neighbor);
+      }
+    }
+  }
+}
+
+template <typename T, typename D, typename Topo>
+bool HuntAndKillStrategy<T, D, Topo>::tryWalk() {
+  auto not_visited_and_connectable = [&](const NeighborList& connectable) {
+    NeighborList matching;
+    for (auto& cell : connectable) {
+      if (!this->g->getCell(cell).visited) {
+        matching.push_back(cell);
+      }
+    }
+    return matching;
+  };
+
+  if (this->g->getCell(this->current_cell).emphasized) {
+    this->g->getCellRef(this->current_cell).emphasized = false;
   }
 
   auto connectable_and_unvisited_cells = not_visited_and_connectable(
-      this->g->getCellIdsMatching(this->current_cell, CONNECTABLE));
+      this->g->getNeighborsMatching(this->current_cell, CONNECTABLE));
 
   if (connectable_and_unvisited_cells.size() == 0) {
-    throw CantWalkException();
+    return false;
   }
 
-  unsigned int choice = rand() % connectable_and_unvisited_cells.size();
+  unsigned int choice =
+      this->rng.below(connectable_and_unvisited_cells.size());
   unsigned int next_cell = connectable_and_unvisited_cells.at(choice);
   this->g->modifyConnection(this->current_cell, next_cell, CONNECTED);
   this->current_cell = next_cell;
-
-  auto curr = this->g->getCell(this->current_cell);
-  curr.visited = true;
-
-  this->g->setCell(this->current_cell, curr);
+  this->visit(this->current_cell);
+  return true;
 }
 
-template <typename T>
-void HuntAndKillStrategy<T>::hunt() {
-  auto visited_and_connectable = [&](std::vector<unsigned int> connectable) {
-    std::vector<unsigned int> matching;
+template <typename T, typename D, typename Topo>
+bool HuntAndKillStrategy<T, D, Topo>::tryHunt() {
+  auto visited_and_connectable = [&](const NeighborList& connectable) {
+    NeighborList matching;
     for (auto& cell : connectable) {
       if (this->g->getCell(cell).visited) {
         matching.push_back(cell);
@@ -65,52 +84,69 @@ void HuntAndKillStrategy<T>::hunt() {
     return matching;
   };
 
-  unsigned int id;
-  std::vector<unsigned int> connectable_and_visited_cells;
-  for (id = 0; id < this->g->num_cells; id++) {
-    if (this->g->getCell(id).visited) {
-      // cell is visited, cannot be a candidate
-      continue;
-    }
-
-    connectable_and_visited_cells =
-        visited_and_connectable(this->g->getCellIdsMatching(id, CONNECTABLE));
-    if (connectable_and_visited_cells.size() == 0) {
-      // cell is not visited, but has no connectable cells that are visited.
-      continue;
-    }
-
-    // cell is not visited, and can be connected to a visited cell, id found.
-    break;
-  }
-
-  if (id >= this->g->num_cells) {
+  if (this->frontier.empty()) {
     // no suitable cell was found
-    throw HuntFailedException();
+    return false;
+  }
+  // every frontier cell is unvisited and can be connected to a visited cell.
+  unsigned int id;
+  if (this->mode == HUNT_RANDOM) {
+    id = this->frontier.at(this->rng.below(this->frontier.size()));
+  } else {
+    id = this->frontier.lowest();
   }
-  unsigned int choice = rand() % connectable_and_visited_cells.size();
+  NeighborList connectable_and_visited_cells =
+      visited_and_connectable(this->g->getNeighborsMatching(id, CONNECTABLE));
+  unsigned int choice =
+      this->rng.below(connectable_and_visited_cells.size());
   unsigned int visited_cell_to_connect_to =
       connectable_and_visited_cells.at(choice);
   this->g->modifyConnection(id, visited_cell_to_connect_to, CONNECTED);
   this->current_cell = id;
+  this->visit(this->current_cell);
+  this->g->getCellRef(this->current_cell).emphasized = true;
+  return true;
+}
 
-  auto curr = this->g->getCell(this->current_cell);
-  curr.visited = true;
-  curr.emphasized = true;
-  this->g->setCell(this->current_cell, curr);
+template <typename T, typename D, typename Topo>
+void HuntAndKillStrategy<T, D, Topo>::walk() {
+  if (!this->tryWalk()) {
+    throw CantWalkException();
+  }
 }
 
-template <typename T>
-float HuntAndKillStrategy<T>::step() {
-  try {
-    this->walk();
-    return 0.000001;
-  } catch (CantWalkException& e) {
-    try {
-      this->hunt();
-      return 1;
-    } catch (HuntFailedException& e) {
-      throw GenerationCompleteException();
-    }
+template <typename T, typename D, typename Topo>
+void HuntAndKillStrategy<T, D, Topo>::hunt() {
+  if (!this->tryHunt()) {
+    throw HuntFailedException();
+  }
+}
+
+template <typename T, typename D, typename Topo>
+StepResult HuntAndKillStrategy<T, D, Topo>::step() {
+  if (this->tryWalk()) {
+    return StepResult{STEP_CONTINUE, 0.000001};
+  }
+  if (this->tryHunt()) {
+    return StepResult{STEP_CONTINUE, 1};
+  }
+  return StepResult{STEP_COMPLETE, 0};
+}
+
+template <typename T, typename D, typename Topo>
+void HuntAndKillStrategy<T, D, Topo>::saveState(std::ostream& out) {
+  writeCheckpointValue(out, this->current_cell);
+  this->rng.saveState(out);
+}
+
+template <typename T, typename D, typename Topo>
+void HuntAndKillStrategy<T, D, Topo>::loadState(std::istream& in) {
+  unsigned int cell = readCheckpointValue<unsigned int>(in);
+  if (cell >= this->g->num_cells) {
+    throw CheckpointException();
   }
+  this->current_cell = cell;
+  this->rng.loadState(in);
+  // the grid has been restored by now, the frontier follows from it.
+  this->rebuildFrontier();
 }
@@ -0,0 +1,62 @@
+#ifndef KRUSKAL_H
+#define KRUSKAL_H
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cell.h"
+#include "checkpoint.h"
+#include "disjoint-sets.h"
+#include "grid.h"
+#include "maze-exceptions.h"
+#include "rng.h"
+#include "step-result.h"
+
+/* KruskalStrategy Overview
+ *
+ * Kruskal's algorithm treats every pair of connectable neighbors as an
+ * edge. The edges are shuffled once, up front, and then taken in that
+ * order: an edge between two cells which are not yet joined by the maze
+ * becomes a passage, any other edge is skipped. The cells already joined to
+ * each other are tracked in a DisjointSets forest.
+ *
+ * Each step carves exactly one passage, skipping as many edges as it must
+ * to find one, so a whole generation takes a pass over the edges with near
+ * constant time finds, and the maze grows all over the grid at once rather
+ * than along a path.
+ * */
+template <typename T = Cell, typename D = DynamicDimensions,
+          typename Topo = OrthogonalTopology>
+struct KruskalStrategy {
+  using Edge = std::tuple<unsigned int, unsigned int>;
+  Grid<T, D, Topo>* g;
+  // state of the generator before the shuffle, so the edge order can be
+  // rebuilt rather than stored in a checkpoint.
+  Rng shuffle_rng;
+  // every pair of connectable neighbors, in the order they are tried.
+  std::vector<Edge> edges;
+  // index of the next edge to try.
+  unsigned int next_edge;
+  unsigned int passages;
+  DisjointSets sets;
+  void initEdges();
+  KruskalStrategy(Grid<T, D, Topo>* grid, Rng r)
+      : g(grid),
+        shuffle_rng(r),
+        next_edge(0),
+        passages(0),
+        sets(grid->num_cells) {
+    this->initEdges();
+  };
+  // without a generator, one is seeded from the system.
+  KruskalStrategy(Grid<T, D, Topo>* grid) : KruskalStrategy(grid, Rng()){};
+  StepResult step();
+  // write or read the progress through the edges to a checkpoint.
+  void saveState(std::ostream&);
+  void loadState(std::istream&);
+};
+#include "kruskal_impl.h"
+#endif
@@ -0,0 +1,69 @@
+template <typename T, typename D, typename Topo>
+void KruskalStrategy<T, D, Topo>::initEdges() {
+  this->edges.clear();
+  this->edges.reserve(this->g->num_cells * Topo::num_directions / 2);
+  for (unsigned int id = 0; id < this->g->num_cells; id++) {
+    // every neighbor, passages already made included, so the edges are the
+    // same on a resumed grid.
+    for (auto status : {CONNECTABLE, CONNECTED}) {
+      for (auto& neighbor : this->g->getNeighborsMatching(id, status)) {
+        // list each edge once, from its lower id.
+        if (neighbor > id) {
+          this->edges.push_back(Edge(id, neighbor));
+        }
+      }
+    }
+  }
+  std::sort(this->edges.begin(), this->edges.end());
+  // fisher-yates, drawing from a copy so the starting state is kept.
+  Rng rng = this->shuffle_rng;
+  for (unsigned int i = this->edges.size(); i > 1; i--) {
+    std::swap(this->edges[i - 1], this->edges[rng.below(i)]);
+  }
+}
+
+template <typename T, typename D, typename Topo>
+StepResult KruskalStrategy<T, D, Topo>::step() {
+  // a spanning tree is complete once it has a passage less than cells.
+  while (this->passages + 1 < this->g->num_cells &&
+         this->next_edge < this->edges.size()) {
+    const auto [id_a, id_b] = this->edges[this->next_edge++];
+    if (!this->sets.unite(id_a, id_b)) {
+      // already joined, a passage here would make a loop.
+      continue;
+    }
+    this->g->modifyConnection(id_a, id_b, CONNECTED);
+    this->g->getCellRef(id_a).visited = true;
+    this->g->getCellRef(id_b).visited = true;
+    this->passages++;
+    return StepResult{STEP_CONTINUE, 0.000001};
+  }
+  return StepResult{STEP_COMPLETE, 0};
+}
+
+template <typename T, typename D, typename Topo>
+void KruskalStrategy<T, D, Topo>::saveState(std::ostream& out) {
+  this->shuffle_rng.saveState(out);
+  writeCheckpointValue(out, this->next_edge);
+}
+
+template <typename T, typename D, typename Topo>
+void KruskalStrategy<T, D, Topo>::loadState(std::istream& in) {
+  this->shuffle_rng.loadState(in);
+  unsigned int edge = readCheckpointValue<unsigned int>(in);
+  this->initEdges();
+  if (edge > this->edges.size()) {
+    throw CheckpointException();
+  }
+  this->next_edge = edge;
+  // the grid has been restored by now, the sets follow from its passages.
+  this->sets.reset();
+  this->passages = 0;
+  for (unsigned int id = 0; id < this->g->num_cells; id++) {
+    for (auto& neighbor : this->g->getNeighborsMatching(id, CONNECTED)) {
+      if (neighbor > id && this->sets.unite(id, neighbor)) {
+        this->passages++;
+      }
+    }
+  }
+}
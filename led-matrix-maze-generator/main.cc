@@ -1,23 +1,71 @@
 #include <getopt.h>
 #include <signal.h>
-#include <time.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <cctype>
+#include <cerrno>
 #include <chrono>
 #include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <limits>
+#include <string>
 
 #include "cell.h"
+#include "double-buffered-canvas.h"
 #include "hunt-and-kill.h"
 #include "led-matrix.h"
+#include "maze-producer.h"
 #include "maze.h"
+#include "replay.h"
+#include "rng.h"
+#include "scrolling-maze.h"
+#include "sharded-maze.h"
 
 #define DEFAULT_ROWS 64
 #define DEFAULT_COLS 64
+// time between each row of pixels when scrolling.
+#define SCROLL_DELAY_USECS 100000
+
+// The grid for a panel of the default size, known at compile time. Cells are
+// two pixels apart, see Maze::distance_between_pixels.
+using DefaultGridDimensions =
+    StaticDimensions<DEFAULT_ROWS / 2, DEFAULT_COLS / 2>;
+
+/* -- CHECKPOINT OPTIONS -- */
+// where to keep the checkpoint of the maze being generated, empty for none.
+static std::string checkpoint_path;
+// how many generation steps to take between checkpoints.
+static unsigned long checkpoint_interval = 100;
+
+/* -- FOOTPRINT OPTIONS -- */
+// whether to print how much memory each maze took once it is generated.
+static bool print_footprint = false;
+
+/* -- RANDOMNESS OPTIONS -- */
+// seed every maze is drawn from when given, so a run can be reproduced.
+static bool seeded = false;
+static uint64_t seed = 0;
+
+/* -- PARALLEL OPTIONS -- */
+// threads to generate each maze on at once, 0 to animate generation.
+static unsigned int parallel_workers = 0;
+
+/* -- DISPLAY OPTIONS -- */
+// whether to scroll through one endless maze instead of drawing new ones.
+static bool scrolling = false;
+// whether to show each maze once it is generated, instead of animating it.
+static bool instant = false;
+// whether to draw each frame offscreen and swap it in on vsync.
+static bool vsync = false;
 
 /* -- INTERRUPT HANDLING FUNCTION --*/
-volatile bool interrupt_received = false;
+// set from the signal handler and read by every shard's worker thread, a
+// lock free atomic is safe for both.
+std::atomic<bool> interrupt_received(false);
+static_assert(std::atomic<bool>::is_always_lock_free,
+              "the interrupt flag is set from a signal handler.");
 static void InterruptHandler(int signo) { interrupt_received = true; }
 
 static void usage(const char *progname, const rgb_matrix::RGBMatrix::Options &d,
@@ -26,13 +74,47 @@ static void usage(const char *progname, const rgb_matrix::RGBMatrix::Options &d,
   fprintf(stderr, "This program draws mazes on an LED Matrix.\n");
   fprintf(stderr, "Options:\n");
   fprintf(stderr, "\t-h                        : shows this help dialog.\n");
+  fprintf(stderr,
+          "\t-c <path>                 : checkpoint generation to <path>, "
+          "and resume from it on start.\n");
+  fprintf(stderr,
+          "\t-n <steps>                : steps between checkpoints. "
+          "Default: %lu\n",
+          checkpoint_interval);
+  fprintf(stderr,
+          "\t-f                        : print the memory footprint of each "
+          "maze once generated.\n");
+  fprintf(stderr,
+          "\t-j <workers>              : generate each maze at once, on "
+          "<workers> threads.\n");
+  fprintf(stderr,
+          "\t--seed <n>                : seed the mazes, so the same seed "
+          "draws the same mazes.\n");
+  fprintf(stderr,
+          "\t--scroll                  : scroll through one endless maze.\n");
+  fprintf(stderr,
+          "\t--instant                 : show each maze once generated, "
+          "rather than as it is generated.\n");
+  fprintf(stderr,
+          "\t--vsync                   : draw each frame offscreen and show "
+          "it on vsync, so no frame is seen half drawn.\n");
   fprintf(stderr, "\n");
   rgb_matrix::PrintMatrixFlags(stderr, d, r);
 }
 
-rgb_matrix::Canvas *init_canvas_from_opts(int argc, char **argv) {
-  srand(time(NULL));
+// parse a whole decimal number, false if there is anything else in text or
+// the number is too big.
+static bool parse_unsigned(const char *text, unsigned long long *value) {
+  if (!isdigit(static_cast<unsigned char>(text[0]))) {
+    return false;
+  }
+  char *end;
+  errno = 0;
+  *value = strtoull(text, &end, 10);
+  return *end == '\0' && errno != ERANGE;
+}
 
+rgb_matrix::RGBMatrix *init_canvas_from_opts(int argc, char **argv) {
   rgb_matrix::RGBMatrix::Options led_options;
   rgb_matrix::RuntimeOptions runtime;
 
@@ -43,52 +125,287 @@ rgb_matrix::Canvas *init_canvas_from_opts(int argc, char **argv) {
   led_options.cols = DEFAULT_COLS;
   runtime.drop_privileges = 1;
 
+  // let the matrix library take its flags first, so getopt only sees ours.
+  if (!rgb_matrix::ParseOptionsFromFlags(&argc, &argv, &led_options,
+                                         &runtime)) {
+    usage(argv[0], led_options, runtime);
+    exit(1);
+  }
+  static const struct option long_options[] = {
+      {"seed", required_argument, NULL, 's'},
+      {"scroll", no_argument, NULL, 'S'},
+      {"instant", no_argument, NULL, 'I'},
+      {"vsync", no_argument, NULL, 'V'},
+      {NULL, 0, NULL, 0}};
   int opt;
-  while ((opt = getopt(argc, argv, "h:")) != -1) {
+  while ((opt = getopt_long(argc, argv, "hc:n:fj:", long_options, NULL)) !=
+         -1) {
     switch (opt) {
       case 'h':
         usage(argv[0], led_options, runtime);
         exit(0);
+      case 'c':
+        checkpoint_path = optarg;
+        break;
+      case 'n':
+        checkpoint_interval = strtoul(optarg, NULL, 10);
+        if (checkpoint_interval == 0) {
+          usage(argv[0], led_options, runtime);
+          exit(1);
+        }
+        break;
+      case 'f':
+        print_footprint = true;
+        break;
+      case 'j': {
+        unsigned long long workers;
+        if (!parse_unsigned(optarg, &workers) || workers == 0 ||
+            workers > std::numeric_limits<unsigned int>::max()) {
+          usage(argv[0], led_options, runtime);
+          exit(1);
+        }
+        parallel_workers = workers;
+        break;
+      }
+      case 's': {
+        unsigned long long value;
+        if (!parse_unsigned(optarg, &value)) {
+          usage(argv[0], led_options, runtime);
+          exit(1);
+        }
+        seed = value;
+        seeded = true;
+        break;
+      }
+      case 'S':
+        scrolling = true;
+        break;
+      case 'I':
+        instant = true;
+        break;
+      case 'V':
+        vsync = true;
+        break;
       default:
         usage(argv[0], led_options, runtime);
         exit(1);
     }
   }
-  if (!rgb_matrix::ParseOptionsFromFlags(&argc, &argv, &led_options,
-                                         &runtime)) {
-    usage(argv[0], led_options, runtime);
-    exit(1);
-  }
   // Looks like we're ready to start
   rgb_matrix::RGBMatrix *matrix =
       rgb_matrix::RGBMatrix::CreateFromOptions(led_options, runtime);
   if (matrix == NULL) {
     exit(1);
   }
-  rgb_matrix::Canvas *canvas = matrix;
-  return canvas;
+  return matrix;
 }
 
-/* -- DRIVER FUNCTION == */
-int main(int argc, char **argv) {
-  // register interrupts
-  signal(SIGTERM, InterruptHandler);
-  signal(SIGINT, InterruptHandler);
+// report the memory a maze holds, and the most it held while generating.
+template <class MazeType>
+static void report_footprint(MazeType &m) {
+  if (!print_footprint) {
+    return;
+  }
+  std::cout << "maze footprint:\n"
+            << m.footprint() << "maze peak footprint:\n"
+            << m.peakFootprint();
+}
 
-  rgb_matrix::Canvas *canvas = init_canvas_from_opts(argc, argv);
+/* -- GENERATION LOOP -- */
+// write a checkpoint, complaining rather than stopping if it fails.
+template <class MazeType>
+static void save_checkpoint(MazeType &m) {
+  try {
+    m.saveCheckpoint(checkpoint_path);
+  } catch (CheckpointException &e) {
+    std::cerr << e.what() << std::endl;
+  }
+}
 
-  //  .. now use canvas
+template <class MazeType, class CanvasType>
+static void run_mazes(CanvasType *canvas, Rng &rng) {
+  bool resume = !checkpoint_path.empty();
   while (!interrupt_received) {
     // Create a maze and tell it to generate
-    Maze<HuntAndKillStrategy<> > m(canvas);
+    MazeType m(canvas, rng.split());
+    const bool resuming =
+        resume && access(checkpoint_path.c_str(), F_OK) == 0;
+    resume = false;
+    if (resuming) {
+      try {
+        m.loadCheckpoint(checkpoint_path);
+      } catch (CheckpointException &e) {
+        // a checkpoint we can't use is no reason not to draw mazes.
+        std::cerr << e.what() << " Starting a new maze." << std::endl;
+        continue;
+      }
+    }
+    // a resumed maze carries on a step at a time, from where it stopped.
+    if (parallel_workers > 0 && !resuming) {
+      m.template generateParallel<HuntAndKillStrategy>(parallel_workers,
+                                                       rng.split());
+    }
+    if (instant && !m.generated) {
+      m.generateAll();
+    }
+    unsigned long steps = 0;
     while (!interrupt_received && !m.generated) {
       float sleep_time_secs = m.generateStep();
       m.updatePixelMap();
+      if (!checkpoint_path.empty() && ++steps % checkpoint_interval == 0) {
+        save_checkpoint(m);
+      }
       usleep(sleep_time_secs * 1000000);
     }
+    if (!checkpoint_path.empty()) {
+      if (m.generated) {
+        // nothing left to resume.
+        remove(checkpoint_path.c_str());
+      } else {
+        save_checkpoint(m);
+      }
+    }
+    report_footprint(m);
     // sleep for a while to bask in the glory of a new maze
     usleep(10 * 1000000);
   }
+}
+
+// without checkpoints or parallel generation to look after, each maze is
+// generated on a producer thread while the one before it is on display, and
+// this loop only replays and draws, see maze-producer.h.
+template <class Dims, class CanvasType>
+static void run_pregenerated_mazes(CanvasType *canvas, Rng &rng) {
+  using MazeType = Maze<ReplayStrategy<Cell, Dims>, Cell, CanvasType, Dims>;
+  MazeProducer<HuntAndKillStrategy, Cell, Dims> producer(
+      canvas->height() / MazeType::distance_between_pixels,
+      canvas->width() / MazeType::distance_between_pixels, rng.split());
+  MazeType m(canvas, producer.next());
+  while (!interrupt_received) {
+    if (instant) {
+      m.generateAll();
+    }
+    while (!interrupt_received && !m.generated) {
+      float sleep_time_secs = m.generateStep();
+      m.updatePixelMap();
+      usleep(sleep_time_secs * 1000000);
+    }
+    report_footprint(m);
+    // sleep for a while to bask in the glory of a new maze, while the next
+    // one is generated.
+    usleep(10 * 1000000);
+    if (!interrupt_received) {
+      m.reset(producer.next());
+    }
+  }
+}
+
+// a chain of default sized panels is generated a panel per thread.
+template <class ShardedMazeType>
+static void run_sharded_mazes(rgb_matrix::Canvas *canvas, Rng &rng) {
+  while (!interrupt_received) {
+    ShardedMazeType m(canvas, DEFAULT_COLS, rng.split());
+    m.generate(interrupt_received, instant ? 0 : 1);
+    report_footprint(m);
+    // sleep for a while to bask in the glory of a new maze
+    usleep(10 * 1000000);
+  }
+}
+
+// one maze, generated a row at a time as it scrolls, for as long as we run.
+template <class CanvasType>
+static void run_scrolling_maze(CanvasType *canvas, Rng &rng) {
+  ScrollingMaze<CanvasType> m(canvas, rng.split());
+  while (!interrupt_received) {
+    m.scroll();
+    usleep(SCROLL_DELAY_USECS);
+  }
+}
+
+// a single panel, or a canvas of any other size, holds a single maze.
+template <class CanvasType>
+static void run_single_mazes(CanvasType *canvas, Rng &rng) {
+  //  .. with a grid sized at compile time if it fits.
+  const bool pregenerate = checkpoint_path.empty() && parallel_workers == 0;
+  if (canvas->height() == DEFAULT_ROWS && canvas->width() == DEFAULT_COLS) {
+    if (pregenerate) {
+      run_pregenerated_mazes<DefaultGridDimensions>(canvas, rng);
+    } else {
+      run_mazes<Maze<HuntAndKillStrategy<Cell, DefaultGridDimensions>, Cell,
+                     CanvasType, DefaultGridDimensions> >(canvas, rng);
+    }
+  } else if (pregenerate) {
+    run_pregenerated_mazes<DynamicDimensions>(canvas, rng);
+  } else {
+    run_mazes<Maze<HuntAndKillStrategy<>, Cell, CanvasType> >(canvas, rng);
+  }
+}
+
+/* -- DRIVER FUNCTION == */
+int main(int argc, char **argv) {
+  // register interrupts
+  signal(SIGTERM, InterruptHandler);
+  signal(SIGINT, InterruptHandler);
+
+  rgb_matrix::RGBMatrix *matrix = init_canvas_from_opts(argc, argv);
+  rgb_matrix::Canvas *canvas = matrix;
+  // each maze draws from its own stream of this generator.
+  Rng rng = seeded ? Rng(seed) : Rng();
+  // frames drawn offscreen, see double-buffered-canvas.h.
+  using VSyncCanvas =
+      DoubleBufferedCanvas<rgb_matrix::RGBMatrix, rgb_matrix::FrameCanvas>;
+
+  //  .. now use canvas.
+  if (scrolling) {
+    if (!checkpoint_path.empty()) {
+      std::cerr << "Checkpoints are not kept for a scrolling maze."
+                << std::endl;
+    }
+    if (parallel_workers > 0) {
+      std::cerr << "A scrolling maze is generated a row at a time, -j is "
+                   "ignored."
+                << std::endl;
+    }
+    if (instant) {
+      std::cerr << "A scrolling maze is shown as it is generated, --instant "
+                   "is ignored."
+                << std::endl;
+    }
+    if (print_footprint) {
+      std::cerr << "Footprints are only printed for mazes that complete, -f "
+                   "is ignored."
+                << std::endl;
+    }
+    if (vsync) {
+      VSyncCanvas frames(matrix);
+      run_scrolling_maze(&frames, rng);
+    } else {
+      run_scrolling_maze(canvas, rng);
+    }
+  } else if (canvas->height() == DEFAULT_ROWS &&
+             canvas->width() != DEFAULT_COLS &&
+             canvas->width() % DEFAULT_COLS == 0) {
+    if (!checkpoint_path.empty()) {
+      std::cerr << "Checkpoints are only kept for a single panel." << std::endl;
+    }
+    if (vsync) {
+      std::cerr << "Frames are only swapped on vsync for a single panel."
+                << std::endl;
+    }
+    if (parallel_workers > 0) {
+      std::cerr << "A chain of panels is generated on a thread per panel, "
+                   "-j is ignored."
+                << std::endl;
+    }
+    using PanelStrategy = HuntAndKillStrategy<Cell, DefaultGridDimensions>;
+    run_sharded_mazes<ShardedMaze<PanelStrategy, Cell, rgb_matrix::Canvas,
+                                  DefaultGridDimensions> >(canvas, rng);
+  } else if (vsync) {
+    VSyncCanvas frames(matrix);
+    run_single_mazes(&frames, rng);
+  } else {
+    run_single_mazes(canvas, rng);
+  }
 
   // Clear the canvas and remove the resources that are used
   canvas->Clear();
@@ -2,3 +2,7 @@
 const char* GenerationCompleteException::what() const throw() {
   return "Maze has been generated, cannot generate further.";
 }
+
+const char* CheckpointException::what() const throw() {
+  return "Checkpoint could not be written, or does not match this maze.";
+}
@@ -4,4 +4,8 @@
 struct GenerationCompleteException : public std::exception {
   const char* what() const throw();
 };
+
+struct CheckpointException : public std::exception {
+  const char* what() const throw();
+};
 #endif
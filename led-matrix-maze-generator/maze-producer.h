@@ -0,0 +1,57 @@
+#ifndef MAZE_PRODUCER_H
+#define MAZE_PRODUCER_H
+#include <memory>
+#include <thread>
+
+#include "bounded-queue.h"
+#include "cell.h"
+#include "generation-log.h"
+#include "grid.h"
+#include "rng.h"
+
+/* MazeProducer Overview
+ *
+ * Generates mazes ahead of time on a background thread, so the next maze is
+ * ready the moment the one on display is done with. Each maze is recorded
+ * as a GenerationLog by running Strategy on the producer's own grid, which
+ * is reset and reused for every maze, and handed over through a bounded
+ * queue:
+ *
+ *   producer thread   record maze n + 1 ... push (waits while full)
+ *   display thread    pop maze n ... replay it ... sit on it a while
+ *
+ * The queue holds capacity mazes, so the producer never runs more than that
+ * far ahead. Each maze is recorded from its own stream split from the
+ * generator handed in, in order, so the same seed gives the same mazes.
+ *
+ * Replaying a log is cheap next to generating, see replay.h, so the display
+ * thread is left with little more than drawing.
+ * */
+template <template <class, class, class> class Strategy, class T = Cell,
+          class D = DynamicDimensions, class Topo = OrthogonalTopology>
+class MazeProducer {
+ public:
+  using Log = GenerationLog<T>;
+  using LogPtr = std::shared_ptr<const Log>;
+
+ private:
+  Grid<T, D, Topo> grid;
+  Rng rng;
+  BoundedQueue<LogPtr> queue;
+  // started last, once everything it uses is in place.
+  std::thread worker;
+  void run();
+
+ public:
+  MazeProducer(unsigned int num_rows, unsigned int num_cols, Rng rng,
+               unsigned int capacity = 1);
+  // stops the producer, waiting for the maze it is recording to finish.
+  ~MazeProducer();
+  // wait for the next maze, nullptr once the producer is stopped.
+  LogPtr next();
+  // mazes recorded and waiting to be taken.
+  unsigned int ready();
+  void stop();
+};
+#include "maze-producer_impl.h"
+#endif
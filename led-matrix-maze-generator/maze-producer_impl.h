@@ -0,0 +1,53 @@
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+MazeProducer<Strategy, T, D, Topo>::MazeProducer(unsigned int num_rows,
+                                                 unsigned int num_cols,
+                                                 Rng rng,
+                                                 unsigned int capacity)
+    : grid(num_rows, num_cols),
+      rng(rng),
+      queue(capacity),
+      worker(&MazeProducer<Strategy, T, D, Topo>::run, this) {}
+
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+MazeProducer<Strategy, T, D, Topo>::~MazeProducer() {
+  this->stop();
+  this->worker.join();
+}
+
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+void MazeProducer<Strategy, T, D, Topo>::run() {
+  while (true) {
+    LogPtr log = std::make_shared<const Log>(
+        Log::template record<Strategy>(&this->grid, this->rng.split()));
+    // push fails once the queue is closed, which ends the thread.
+    if (!this->queue.push(log)) {
+      return;
+    }
+  }
+}
+
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+typename MazeProducer<Strategy, T, D, Topo>::LogPtr
+MazeProducer<Strategy, T, D, Topo>::next() {
+  LogPtr log;
+  if (!this->queue.pop(log)) {
+    return nullptr;
+  }
+  return log;
+}
+
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+unsigned int MazeProducer<Strategy, T, D, Topo>::ready() {
+  return this->queue.size();
+}
+
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+void MazeProducer<Strategy, T, D, Topo>::stop() {
+  this->queue.close();
+}
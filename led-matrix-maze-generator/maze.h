@@ -1,26 +1,32 @@
 #ifndef MAZE_H
 #define MAZE_H
 #include <algorithm>
-#include <exception>
+#include <string>
 #include <tuple>
 
 #include "cell.h"
+#include "checkpoint.h"
+#include "damage-tracker.h"
+#include "double-buffered-canvas.h"
+#include "footprint.h"
+#include "frame-buffer.h"
 #include "grid.h"
 #include "led-matrix.h"
 #include "maze-exceptions.h"
+#include "region-generation.h"
+#include "rng.h"
+#include "segment-rasterizer.h"
+#include "step-result.h"
 
-struct SlopeDNEException : public std::exception {
-  const char* what() const throw();
-};
-
-template <typename T1, typename T2 = Cell, typename T3 = rgb_matrix::Canvas>
+template <typename T1, typename T2 = Cell, typename T3 = rgb_matrix::Canvas,
+          typename D = DynamicDimensions, typename Topo = OrthogonalTopology>
 class Maze {
  public:
   using Coord = std::tuple<unsigned int, unsigned int>;
-  using CoordList = std::vector<Coord>;
-  using Pixel = std::tuple<unsigned int, unsigned int, unsigned int>;
-  using PixelRow = std::vector<Pixel>;
-  using PixelMap = std::vector<PixelRow>;
+  using Pixel = FrameBuffer::Pixel;
+  using PixelMap = FrameBuffer;
+  using IdList = std::vector<unsigned int>;
+  using ConnectionList = std::vector<std::tuple<unsigned int, unsigned int>>;
   static const int distance_between_pixels = 2;
   bool generated;
 
@@ -31,17 +37,27 @@ class Maze {
   Pixel emphasized_color = {255, 0, 0};
   unsigned int height;
   unsigned int width;
-  Grid<T2> grid;
+  Grid<T2, D, Topo> grid;
   T1 generation_strategy;
   T3* canvas;
   PixelMap map;
-  CoordList pixels_to_update;
+  // pixels of the map that have changed since they were last drawn.
+  DamageTracker pixels_to_update;
+  // buffers the grid's modifications are drained into, kept between updates
+  // so draining never allocates.
+  IdList modified_cells;
+  ConnectionList modified_connections;
+  // largest footprint seen at each update.
+  MazeFootprint peak_footprint;
   PixelMap initMap();
+  // put the map back the way initMap makes it, queueing the pixels that
+  // change to be drawn.
+  void resetMap();
   void drawMap();
   Coord getCoordOfCellById(unsigned int);
-  int getSlope(Coord, Coord);
   void updateConnectionInPixelMap(unsigned int, unsigned int);
   void updateCellInPixelMap(unsigned int);
+  void updateExitsInPixelMap(unsigned int);
   void drawMapUpdates();
 
  public:
@@ -49,17 +65,70 @@ class Maze {
       : generated(false),
         height(c->height()),
         width(c->width()),
-        grid(Grid<T2>(c->height() / distance_between_pixels,
-                      c->width() / distance_between_pixels)),
+        grid(Grid<T2, D, Topo>(c->height() / distance_between_pixels,
+                               c->width() / distance_between_pixels)),
         generation_strategy(T1(&grid)),
         canvas(c),
-        map(initMap()) {
+        map(initMap()),
+        pixels_to_update(height, width) {
+    drawMap();
+  };
+  // hand the strategy whatever else it is created with, such as its random
+  // number generator so the maze can be reproduced, or the log it replays.
+  template <class... Args>
+  Maze(T3* c, Args... args)
+      : generated(false),
+        height(c->height()),
+        width(c->width()),
+        grid(Grid<T2, D, Topo>(c->height() / distance_between_pixels,
+                               c->width() / distance_between_pixels)),
+        generation_strategy(T1(&grid, args...)),
+        canvas(c),
+        map(initMap()),
+        pixels_to_update(height, width) {
     drawMap();
   };
+  // start over on a new maze, creating the strategy from args as the
+  // constructor does. The grid and pixel map are reused rather than
+  // reallocated, and only the pixels that change are drawn.
+  template <class... Args>
+  void reset(Args... args);
 
+  // take a step of the generation strategy, throws if the maze is already
+  // generated. generateStep gives back just the delay.
+  StepResult advance();
   float generateStep();
-  PixelMap generatePixelMap();
+  // take up to n steps without waiting between them, or every step left
+  // for generateAll, and draw what changed once at the end. Drawing every
+  // render_every steps as well shows progress, 0 draws only at the end.
+  // Both give back the number of steps taken, and stop early once the maze
+  // is generated.
+  unsigned int generateSteps(unsigned int n, unsigned int render_every = 0);
+  unsigned int generateAll(unsigned int render_every = 0);
+  // generate the whole maze at once, in regions carved in parallel by
+  // Strategy, see region-generation.h, and draw it. The maze's own strategy
+  // is left unused.
+  template <template <class, class, class> class Strategy>
+  void generateParallel(unsigned int num_regions, Rng rng);
+  // redraw every connection and cell into the pixel map, and view it.
+  const PixelMap& generatePixelMap();
   void updatePixelMap();
+  // query, open or close the exit of a cell off the edge of the maze, see
+  // grid.h. An exit is drawn up to the edge of the map at the next update.
+  ConnectionStatus queryExit(unsigned int, unsigned int);
+  void modifyExit(unsigned int, unsigned int, ConnectionStatus);
+  // cells with a single passage, and with three or more, so far.
+  unsigned int countDeadEnds();
+  unsigned int countJunctions();
+  // bytes held by each part of the maze right now, and the most each part
+  // has held at any update so far.
+  MazeFootprint footprint();
+  MazeFootprint peakFootprint();
+  // write the maze's progress to a checkpoint file, replacing any previous
+  // one only once the new one is synced to disk, or resume from one.
+  // Resuming redraws the whole canvas.
+  void saveCheckpoint(const std::string&);
+  void loadCheckpoint(const std::string&);
 };
 #include "maze_impl.h"
 #endif
@@ -1,190 +1,312 @@
-const char* SlopeDNEException::what() const throw() {
-  return "Line is vertical, slope does not exist.";
-}
+#include <fstream>
+#include <limits>
+#include <sstream>
 
-template <typename T1, typename T2, typename T3>
-typename Maze<T1, T2, T3>::PixelMap Maze<T1, T2, T3>::initMap() {
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+typename Maze<T1, T2, T3, D, Topo>::PixelMap
+Maze<T1, T2, T3, D, Topo>::initMap() {
   // first set everything as wall color
-  Maze<T1, T2, T3>::PixelMap map(
-      height, Maze<T1, T2, T3>::PixelRow(width, Maze<T1, T2, T3>::wall_color));
+  Maze<T1, T2, T3, D, Topo>::PixelMap map(
+      height, width, Maze<T1, T2, T3, D, Topo>::wall_color);
 
   // go through and set each pixel corresponding to a cell as the not connected
   // color
   for (unsigned int i = 0; i < this->grid.num_cells; i++) {
     const auto [current_row, current_col] = this->grid.getRowColFromId(i);
     unsigned int current_x_pos =
-        current_row * Maze<T1, T2, T3>::distance_between_pixels;
+        current_row * Maze<T1, T2, T3, D, Topo>::distance_between_pixels;
     unsigned int current_y_pos =
-        current_col * Maze<T1, T2, T3>::distance_between_pixels;
-    map[current_x_pos][current_y_pos] = Maze<T1, T2, T3>::not_connected_color;
+        current_col * Maze<T1, T2, T3, D, Topo>::distance_between_pixels;
+    map.set(current_x_pos, current_y_pos,
+            Maze<T1, T2, T3, D, Topo>::not_connected_color);
   }
   return map;
 }
 
-template <typename T1, typename T2, typename T3>
-void Maze<T1, T2, T3>::drawMap() {
-  // for each pixel in the map, set it on the canvas
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::resetMap() {
   for (unsigned int i = 0; i < this->height; i++) {
     for (unsigned int j = 0; j < this->width; j++) {
-      const auto [pixel_r, pixel_g, pixel_b] = this->map[i][j];
-      this->canvas->SetPixel(i, j, pixel_r, pixel_g, pixel_b);
+      // pixels of cells start out not connected, as in initMap.
+      const bool is_cell =
+          i % distance_between_pixels == 0 &&
+          j % distance_between_pixels == 0 &&
+          i / distance_between_pixels < this->grid.num_rows &&
+          j / distance_between_pixels < this->grid.num_cols;
+      const Pixel& color =
+          is_cell ? this->not_connected_color : this->wall_color;
+      if (this->map.get(i, j) != color) {
+        this->map.set(i, j, color);
+        this->pixels_to_update.mark(i, j);
+      }
     }
   }
 }
 
-template <typename T1, typename T2, typename T3>
-typename Maze<T1, T2, T3>::Coord Maze<T1, T2, T3>::getCoordOfCellById(
-    unsigned int id) {
-  const auto [row, col] = this->grid.getRowColFromId(id);
-  unsigned int x = row * Maze<T1, T2, T3>::distance_between_pixels;
-  unsigned int y = col * Maze<T1, T2, T3>::distance_between_pixels;
-  return Maze<T1, T2, T3>::Coord(x, y);
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::drawMap() {
+  // set each row of the map on the canvas as a run. the map is indexed by
+  // row first, the canvas takes the column first.
+  for (unsigned int i = 0; i < this->height; i++) {
+    drawPixelRun(this->canvas, 0, i, this->map.pixelBytes(i, 0), this->width);
+  }
+  presentFrame(this->canvas);
 }
 
-template <typename T1, typename T2, typename T3>
-int Maze<T1, T2, T3>::getSlope(typename ::Maze<T1, T2, T3>::Coord a,
-                               typename ::Maze<T1, T2, T3>::Coord b) {
-  const auto [x1, y1] = a;
-  const auto [x2, y2] = b;
-  if (x2 - x1 == 0) {
-    throw SlopeDNEException();
-  }
-  return ((y2 - y1) / (x2 - x1));
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+typename Maze<T1, T2, T3, D, Topo>::Coord
+Maze<T1, T2, T3, D, Topo>::getCoordOfCellById(
+    unsigned int id) {
+  const auto [row, col] = this->grid.getRowColFromId(id);
+  unsigned int x = row * Maze<T1, T2, T3, D, Topo>::distance_between_pixels;
+  unsigned int y = col * Maze<T1, T2, T3, D, Topo>::distance_between_pixels;
+  return Maze<T1, T2, T3, D, Topo>::Coord(x, y);
 }
 
-template <typename T1, typename T2, typename T3>
-void Maze<T1, T2, T3>::updateConnectionInPixelMap(unsigned int p1,
-                                                  unsigned int p2) {
-  const auto p1Coord = this->getCoordOfCellById(p1);
-  const auto [p1_x, p1_y] = p1Coord;
-  const auto p2Coord = this->getCoordOfCellById(p2);
-  const auto [p2_x, p2_y] = p2Coord;
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::updateConnectionInPixelMap(unsigned int p1,
+                                                           unsigned int p2) {
+  const auto [p1_x, p1_y] = this->getCoordOfCellById(p1);
+  const auto [p2_x, p2_y] = this->getCoordOfCellById(p2);
   const auto status = this->grid.queryConnection(p1, p2);
   Pixel draw_color;
   if (status == CONNECTED) {
-    draw_color = Maze<T1, T2, T3>::connected_color;
+    draw_color = Maze<T1, T2, T3, D, Topo>::connected_color;
   } else {
-    draw_color = Maze<T1, T2, T3>::wall_color;
-  }
-
-  // try to get the slope between the two points for drawing.
-  // because we are in a grid, and cells can only be connected to their
-  // neighbors, slope is either 0 or DNE, but in the future I may want
-  // to connect to say, the upper left node, or lower right. instead of
-  // just up, left, down, and right.
-  try {
-    // y = mx + b
-    // y - mx = b
-    int slope = this->getSlope(p1Coord, p2Coord);
-    int b = p1_y - (slope * p1_x);
-    for (unsigned int x = p1_x; x <= p2_x; x++) {
-      int y = (slope * x) + b;
-      this->map[x][y] = draw_color;
-      Coord c(x, y);
-      this->pixels_to_update.push_back(c);
-    }
-  } catch (SlopeDNEException& e) {
-    // if slope does not exist, its a vertical line, so set x constant and move
-    // y
-    int x = p1_x;
-    int y1, y2;
-    if (p1_y < p2_y) {
-      y1 = p1_y;
-      y2 = p2_y;
-    } else {
-      y1 = p2_y;
-      y2 = p1_y;
-    }
-    for (int y = y1; y <= y2; y++) {
-      this->map[x][y] = draw_color;
-      Coord c(x, y);
-      this->pixels_to_update.push_back(c);
+    draw_color = Maze<T1, T2, T3, D, Topo>::wall_color;
+  }
+
+  // cells can only be connected to their neighbors, so a passage is a
+  // horizontal or vertical line for the orthogonal topology, and can also be
+  // a diagonal one for the diagonal and hex topologies.
+  rasterizeSegment(p1_x, p1_y, p2_x, p2_y, [&](int x, int y) {
+    this->map.set(x, y, draw_color);
+    this->pixels_to_update.mark(x, y);
+  });
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::updateExitsInPixelMap(unsigned int p) {
+  const auto [row, col] = this->grid.getRowColFromId(p);
+  const auto [x, y] = this->getCoordOfCellById(p);
+  for (unsigned int d = 0; d < Topo::num_directions; d++) {
+    const auto status = this->grid.queryExit(p, d);
+    if (status == NOT_CONNECTABLE) {
+      continue;
     }
+    const Pixel& draw_color = status == CONNECTED
+                                  ? Maze<T1, T2, T3, D, Topo>::connected_color
+                                  : Maze<T1, T2, T3, D, Topo>::wall_color;
+    // toward where the neighbor would be, as far as the edge of the map.
+    const int* offset = Topo::offsets[Topo::getParity(row)][d];
+    const int to_x = int(x) + offset[0] * distance_between_pixels;
+    const int to_y = int(y) + offset[1] * distance_between_pixels;
+    rasterizeSegment(x, y, to_x, to_y, [&](int px, int py) {
+      if ((px == int(x) && py == int(y)) || px < 0 || py < 0 ||
+          px >= int(this->height) || py >= int(this->width)) {
+        return;
+      }
+      this->map.set(px, py, draw_color);
+      this->pixels_to_update.mark(px, py);
+    });
   }
 }
 
-template <typename T1, typename T2, typename T3>
-void Maze<T1, T2, T3>::updateCellInPixelMap(unsigned int p) {
-  const auto coord = this->getCoordOfCellById(p);
-  this->pixels_to_update.push_back(coord);
-  const auto [x, y] = coord;
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::updateCellInPixelMap(unsigned int p) {
+  const auto [x, y] = this->getCoordOfCellById(p);
+  this->pixels_to_update.mark(x, y);
+  this->updateExitsInPixelMap(p);
   if (this->grid.getCell(p).emphasized) {
-    this->map[x][y] = Maze<T1, T2, T3>::emphasized_color;
+    this->map.set(x, y, Maze<T1, T2, T3, D, Topo>::emphasized_color);
     return;
   }
-  auto connected = this->grid.getCellIdsMatching(p, CONNECTED);
-  if (connected.size() > 0) {
-    this->map[x][y] = Maze<T1, T2, T3>::connected_color;
+  if (this->grid.getDegree(p) > 0) {
+    this->map.set(x, y, Maze<T1, T2, T3, D, Topo>::connected_color);
   } else {
-    this->map[x][y] = Maze<T1, T2, T3>::not_connected_color;
-  }
-}
-
-template <typename T1, typename T2, typename T3>
-void Maze<T1, T2, T3>::drawMapUpdates() {
-  auto compareCoords = [&](Maze<T1, T2, T3>::Coord a,
-                           Maze<T1, T2, T3>::Coord b) {
-    auto const [x1, y1] = a;
-    auto const [x2, y2] = b;
-    return (x1 == x2 && y1 == y2);
-  };
-  std::sort(this->pixels_to_update.begin(), this->pixels_to_update.end());
-  Maze<T1, T2, T3>::CoordList::iterator i;
-  i = std::unique(
-      this->pixels_to_update.begin(),
-      this->pixels_to_update.begin() + this->pixels_to_update.size(),
-      compareCoords);
-  this->pixels_to_update.resize(
-      std::distance(this->pixels_to_update.begin(), i));
-  for (auto pixel : this->pixels_to_update) {
-    auto const [x, y] = pixel;
-    auto const [r, g, b] = this->map[x][y];
-    this->canvas->SetPixel(x, y, r, g, b);
+    this->map.set(x, y, Maze<T1, T2, T3, D, Topo>::not_connected_color);
   }
-  this->pixels_to_update.clear();
 }
 
-template <typename T1, typename T2, typename T3>
-typename Maze<T1, T2, T3>::PixelMap Maze<T1, T2, T3>::generatePixelMap() {
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::drawMapUpdates() {
+  // each changed pixel is drawn once, in runs along the rows of the map.
+  this->pixels_to_update.flush(
+      [this](unsigned int row, unsigned int col, unsigned int count) {
+        drawPixelRun(this->canvas, col, row, this->map.pixelBytes(row, col),
+                     count);
+      });
+  presentFrame(this->canvas);
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+const typename Maze<T1, T2, T3, D, Topo>::PixelMap&
+Maze<T1, T2, T3, D, Topo>::generatePixelMap() {
+  // each passage is listed from both of its cells, draw it only from the
+  // lower id so it is drawn once.
   for (unsigned int i = 0; i < this->grid.num_cells; i++) {
-    for (unsigned int j = i; j < this->grid.num_cells; j++) {
-      const auto status = grid.queryConnection(i, j);
-      if (status != CONNECTED) {
-        continue;
+    for (auto& neighbor : this->grid.getNeighborsMatching(i, CONNECTED)) {
+      if (neighbor > i) {
+        this->updateConnectionInPixelMap(i, neighbor);
       }
-      this->updateConnectionInPixelMap(i, j);
     }
   }
   for (unsigned int i = 0; i < this->grid.num_cells; i++) {
     this->updateCellInPixelMap(i);
   }
-  return map;
+  return this->map;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+template <class... Args>
+void Maze<T1, T2, T3, D, Topo>::reset(Args... args) {
+  this->grid.reset();
+  this->generation_strategy = T1(&this->grid, args...);
+  this->generated = false;
+  this->resetMap();
+  // draws whatever the new strategy did to the grid on creation as well.
+  this->updatePixelMap();
 }
 
-template <typename T1, typename T2, typename T3>
-float Maze<T1, T2, T3>::generateStep() {
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+StepResult Maze<T1, T2, T3, D, Topo>::advance() {
   if (this->generated) {
     throw GenerationCompleteException();
   }
 
-  try {
-    return this->generation_strategy.step();
-  } catch (GenerationCompleteException& e) {
+  StepResult result = this->generation_strategy.step();
+  if (result.status == STEP_COMPLETE) {
     this->generated = true;
-    return 0;
   }
+  return result;
 }
 
-template <typename T1, typename T2, typename T3>
-void Maze<T1, T2, T3>::updatePixelMap() {
-  auto modified_connections = this->grid.getRecentlyModifiedConnections();
-  for (auto& conn : modified_connections) {
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+float Maze<T1, T2, T3, D, Topo>::generateStep() {
+  return this->advance().delay;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+unsigned int Maze<T1, T2, T3, D, Topo>::generateSteps(
+    unsigned int n, unsigned int render_every) {
+  if (this->generated) {
+    throw GenerationCompleteException();
+  }
+
+  unsigned int steps = 0;
+  while (steps < n && !this->generated) {
+    this->advance();
+    steps++;
+    if (render_every > 0 && steps % render_every == 0) {
+      this->updatePixelMap();
+    }
+  }
+  // the journal holds each change once, however many steps made it.
+  this->updatePixelMap();
+  return steps;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+unsigned int Maze<T1, T2, T3, D, Topo>::generateAll(unsigned int render_every) {
+  return this->generateSteps(std::numeric_limits<unsigned int>::max(),
+                             render_every);
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+template <template <class, class, class> class Strategy>
+void Maze<T1, T2, T3, D, Topo>::generateParallel(unsigned int num_regions,
+                                                 Rng rng) {
+  if (this->generated) {
+    throw GenerationCompleteException();
+  }
+  generateInRegions<Strategy>(&this->grid, num_regions, rng);
+  this->generated = true;
+  this->updatePixelMap();
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::updatePixelMap() {
+  this->grid.drainRecentlyModifiedConnections(this->modified_connections);
+  for (auto& conn : this->modified_connections) {
     const auto [id1, id2] = conn;
     this->updateConnectionInPixelMap(id1, id2);
   }
-  auto modified_cells = this->grid.getRecentlyModifiedCells();
-  for (auto& cell : modified_cells) {
+  this->grid.drainRecentlyModifiedCells(this->modified_cells);
+  for (auto& cell : this->modified_cells) {
     this->updateCellInPixelMap(cell);
   }
+  // everything this update needs is allocated by now.
+  this->peak_footprint.raiseTo(this->footprint());
   this->drawMapUpdates();
 }
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::saveCheckpoint(const std::string& path) {
+  // build the checkpoint in memory, then replace the file in one go, see
+  // replaceCheckpointFile.
+  std::ostringstream out(std::ios::binary);
+  writeCheckpointValue<uint32_t>(out, CHECKPOINT_MAGIC);
+  writeCheckpointValue<uint32_t>(out, CHECKPOINT_VERSION);
+  writeCheckpointValue<uint8_t>(out, this->generated);
+  this->grid.saveState(out);
+  this->generation_strategy.saveState(out);
+  replaceCheckpointFile(path, out.str());
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::loadCheckpoint(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  expectCheckpointValue<uint32_t>(in, CHECKPOINT_MAGIC);
+  expectCheckpointValue<uint32_t>(in, CHECKPOINT_VERSION);
+  this->generated = readCheckpointValue<uint8_t>(in) != 0;
+  this->grid.loadState(in);
+  this->generation_strategy.loadState(in);
+
+  // anything journaled before the load describes the old maze.
+  this->grid.drainRecentlyModifiedConnections(this->modified_connections);
+  this->grid.drainRecentlyModifiedCells(this->modified_cells);
+  this->resetMap();
+  this->generatePixelMap();
+  this->pixels_to_update.clear();
+  this->drawMap();
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+ConnectionStatus Maze<T1, T2, T3, D, Topo>::queryExit(unsigned int id,
+                                                      unsigned int d) {
+  return this->grid.queryExit(id, d);
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void Maze<T1, T2, T3, D, Topo>::modifyExit(unsigned int id, unsigned int d,
+                                           ConnectionStatus status) {
+  this->grid.modifyExit(id, d, status);
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+unsigned int Maze<T1, T2, T3, D, Topo>::countDeadEnds() {
+  return this->grid.countDeadEnds();
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+unsigned int Maze<T1, T2, T3, D, Topo>::countJunctions() {
+  return this->grid.countJunctions();
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+MazeFootprint Maze<T1, T2, T3, D, Topo>::footprint() {
+  MazeFootprint f;
+  f.grid = this->grid.footprint();
+  f.pixel_map = this->map.footprint();
+  f.pixels_to_update = this->pixels_to_update.footprint();
+  f.modified_buffers = storageFootprint(this->modified_cells) +
+                       storageFootprint(this->modified_connections);
+  return f;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+MazeFootprint Maze<T1, T2, T3, D, Topo>::peakFootprint() {
+  MazeFootprint peak = this->peak_footprint;
+  peak.raiseTo(this->footprint());
+  return peak;
+}
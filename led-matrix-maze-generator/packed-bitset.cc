@@ -0,0 +1,67 @@
+#include "packed-bitset.h"
+
+#include <algorithm>
+
+#include "checkpoint.h"
+
+void PackedBitset::clear() { std::fill(words.begin(), words.end(), 0); }
+
+unsigned int PackedBitset::count() const {
+  unsigned int total = 0;
+  for (auto& word : words) {
+    total += __builtin_popcountll(word);
+  }
+  return total;
+}
+
+unsigned int PackedBitset::findFirstSet(unsigned int i) const {
+  if (i >= num_bits) {
+    return num_bits;
+  }
+  unsigned int w = i / bits_per_word;
+  // ignore the bits before i in the first word.
+  Word word = words[w] & (~Word(0) << (i % bits_per_word));
+  while (word == 0) {
+    if (++w >= words.size()) {
+      return num_bits;
+    }
+    word = words[w];
+  }
+  unsigned int found = w * bits_per_word + __builtin_ctzll(word);
+  return std::min(found, num_bits);
+}
+
+unsigned int PackedBitset::findFirstUnset(unsigned int i) const {
+  if (i >= num_bits) {
+    return num_bits;
+  }
+  unsigned int w = i / bits_per_word;
+  // look for set bits in the inverted word, ignoring the bits before i.
+  Word word = ~words[w] & (~Word(0) << (i % bits_per_word));
+  while (word == 0) {
+    if (++w >= words.size()) {
+      return num_bits;
+    }
+    word = ~words[w];
+  }
+  // the padding bits past num_bits in the last word are always unset, so
+  // clamp anything found there.
+  unsigned int found = w * bits_per_word + __builtin_ctzll(word);
+  return std::min(found, num_bits);
+}
+
+void PackedBitset::saveState(std::ostream& out) const {
+  writeCheckpointValue(out, this->num_bits);
+  writeCheckpointBytes(out, this->words.data(),
+                       this->words.size() * sizeof(Word));
+}
+
+void PackedBitset::loadState(std::istream& in) {
+  expectCheckpointValue(in, this->num_bits);
+  readCheckpointBytes(in, this->words.data(),
+                      this->words.size() * sizeof(Word));
+  // keep the padding past num_bits unset, as the queries rely on it.
+  if (this->num_bits % bits_per_word != 0) {
+    this->words.back() &= (Word(1) << (this->num_bits % bits_per_word)) - 1;
+  }
+}
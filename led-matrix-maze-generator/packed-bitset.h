@@ -0,0 +1,82 @@
+#ifndef PACKED_BITSET_H
+#define PACKED_BITSET_H
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// PackedBitset is a fixed size set of bits stored 64 to a word, so that
+// questions about many bits at once ("how many are set", "where is the next
+// unset one") can be answered a word at a time instead of a bit at a time.
+class PackedBitset {
+ public:
+  using Word = uint64_t;
+  static const unsigned int bits_per_word = 64;
+
+  // reference is a proxy for a single bit, which behaves like a bool& would.
+  class reference {
+    Word* word;
+    Word mask;
+
+   public:
+    reference(Word* w, Word m) : word(w), mask(m){};
+    operator bool() const { return (*word & mask) != 0; }
+    reference& operator=(bool value) {
+      if (value) {
+        *word |= mask;
+      } else {
+        *word &= ~mask;
+      }
+      return *this;
+    }
+    reference& operator=(const reference& other) {
+      return *this = static_cast<bool>(other);
+    }
+  };
+
+ private:
+  unsigned int num_bits;
+  std::vector<Word> words;
+
+ public:
+  PackedBitset(unsigned int num_bits = 0)
+      : num_bits(num_bits),
+        words((num_bits + bits_per_word - 1) / bits_per_word, 0){};
+
+  // number of bits in the set.
+  unsigned int size() const { return num_bits; }
+  // query a single bit.
+  bool test(unsigned int i) const {
+    return (words[i / bits_per_word] >> (i % bits_per_word)) & 1;
+  }
+  // modify a single bit.
+  void set(unsigned int i, bool value = true) {
+    Word mask = Word(1) << (i % bits_per_word);
+    if (value) {
+      words[i / bits_per_word] |= mask;
+    } else {
+      words[i / bits_per_word] &= ~mask;
+    }
+  }
+  void reset(unsigned int i) { set(i, false); }
+  // get a proxy to a single bit.
+  reference operator[](unsigned int i) {
+    return reference(&words[i / bits_per_word],
+                     Word(1) << (i % bits_per_word));
+  }
+  // bytes allocated for the words.
+  size_t footprint() const { return words.capacity() * sizeof(Word); }
+  // unset every bit.
+  void clear();
+  // count the bits that are set.
+  unsigned int count() const;
+  // find the first set bit at or after i, size() if there is none.
+  unsigned int findFirstSet(unsigned int i) const;
+  // find the first unset bit at or after i, size() if there is none.
+  unsigned int findFirstUnset(unsigned int i) const;
+  // write or read the bits to a checkpoint, the sizes must match.
+  void saveState(std::ostream& out) const;
+  void loadState(std::istream& in);
+};
+#endif
@@ -0,0 +1,43 @@
+#ifndef PANEL_CANVAS_H
+#define PANEL_CANVAS_H
+#include <cstdint>
+#include <mutex>
+
+#include "frame-buffer.h"
+
+// PanelCanvas is a window onto one panel of a chain, it looks like a canvas
+// of the panel's size to whatever draws on it, and forwards each pixel to
+// the chained canvas shifted over by the panel's offset. Several panels may
+// be drawn on from different threads, they share a lock around the chained
+// canvas.
+template <class Canvas>
+class PanelCanvas {
+  Canvas* canvas;
+  std::mutex* canvas_lock;
+  int x_offset;
+  int w;
+  int h;
+
+ public:
+  PanelCanvas(Canvas* c, std::mutex* lock, int x_offset, int width)
+      : canvas(c),
+        canvas_lock(lock),
+        x_offset(x_offset),
+        w(width),
+        h(c->height()){};
+  int width() { return this->w; };
+  int height() { return this->h; };
+  void SetPixel(int x, int y, int r, int g, int b) {
+    std::lock_guard<std::mutex> guard(*this->canvas_lock);
+    this->canvas->SetPixel(x + this->x_offset, y, r, g, b);
+  };
+  // a run of packed RGB888 pixels along a row, taking the lock once for
+  // the whole run, see drawPixelRun in damage-tracker.h.
+  void SetPixelRun(int x, int y, const uint8_t* rgb, int count) {
+    std::lock_guard<std::mutex> guard(*this->canvas_lock);
+    for (int i = 0; i < count; i++, rgb += FrameBuffer::bytes_per_pixel) {
+      this->canvas->SetPixel(x + this->x_offset + i, y, rgb[0], rgb[1], rgb[2]);
+    }
+  };
+};
+#endif
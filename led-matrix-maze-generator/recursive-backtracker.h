@@ -0,0 +1,47 @@
+#ifndef RECURSIVE_BACKTRACKER_H
+#define RECURSIVE_BACKTRACKER_H
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "cell.h"
+#include "checkpoint.h"
+#include "grid.h"
+#include "maze-exceptions.h"
+#include "rng.h"
+#include "step-result.h"
+
+/* RecursiveBacktrackerStrategy Overview
+ *
+ * A depth first generation strategy. Each step either carves a passage from
+ * the cell on top of the stack to a random unvisited neighbor and pushes
+ * it, or, when the top cell has no unvisited neighbors left, pops it to
+ * back up one cell. Generation is complete once the stack is empty.
+ *
+ * The stack is explicit rather than recursion, and is reserved for every
+ * cell of the grid when the strategy is created, since no cell is ever on
+ * it twice. Stepping never allocates, and every step is constant time.
+ * */
+template <typename T = Cell, typename D = DynamicDimensions,
+          typename Topo = OrthogonalTopology>
+struct RecursiveBacktrackerStrategy {
+  Grid<T, D, Topo>* g;
+  // every random choice is drawn from here, see rng.h.
+  Rng rng;
+  // path from the starting cell to the current cell.
+  std::vector<unsigned int> stack;
+  unsigned int current_cell;
+  unsigned int init_current_cell();
+  RecursiveBacktrackerStrategy(Grid<T, D, Topo>* grid, Rng r)
+      : g(grid), rng(r), current_cell(init_current_cell()){};
+  // without a generator, one is seeded from the system.
+  RecursiveBacktrackerStrategy(Grid<T, D, Topo>* grid)
+      : RecursiveBacktrackerStrategy(grid, Rng()){};
+  StepResult step();
+  // write or read the stack, and the state of the generator, to a
+  // checkpoint.
+  void saveState(std::ostream&);
+  void loadState(std::istream&);
+};
+#include "recursive-backtracker_impl.h"
+#endif
@@ -0,0 +1,68 @@
+template <typename T, typename D, typename Topo>
+unsigned int RecursiveBacktrackerStrategy<T, D, Topo>::init_current_cell() {
+  this->stack.reserve(this->g->num_cells);
+  unsigned int starting_cell = this->rng.below(this->g->num_cells);
+  this->g->getCellRef(starting_cell).visited = true;
+  this->stack.push_back(starting_cell);
+  return starting_cell;
+}
+
+template <typename T, typename D, typename Topo>
+StepResult RecursiveBacktrackerStrategy<T, D, Topo>::step() {
+  if (this->stack.empty()) {
+    return StepResult{STEP_COMPLETE, 0};
+  }
+
+  this->current_cell = this->stack.back();
+  NeighborList unvisited;
+  for (auto& cell :
+       this->g->getNeighborsMatching(this->current_cell, CONNECTABLE)) {
+    if (!this->g->getCell(cell).visited) {
+      unvisited.push_back(cell);
+    }
+  }
+
+  if (unvisited.size() == 0) {
+    // dead end, back up to the previous cell on the path.
+    this->stack.pop_back();
+    if (!this->stack.empty()) {
+      this->current_cell = this->stack.back();
+    }
+    return StepResult{STEP_CONTINUE, 0.000001};
+  }
+
+  unsigned int next_cell = unvisited.at(this->rng.below(unvisited.size()));
+  this->g->modifyConnection(this->current_cell, next_cell, CONNECTED);
+  this->g->getCellRef(next_cell).visited = true;
+  this->stack.push_back(next_cell);
+  this->current_cell = next_cell;
+  return StepResult{STEP_CONTINUE, 0.000001};
+}
+
+template <typename T, typename D, typename Topo>
+void RecursiveBacktrackerStrategy<T, D, Topo>::saveState(std::ostream& out) {
+  writeCheckpointValue<unsigned int>(out, this->stack.size());
+  writeCheckpointBytes(out, this->stack.data(),
+                       this->stack.size() * sizeof(unsigned int));
+  this->rng.saveState(out);
+}
+
+template <typename T, typename D, typename Topo>
+void RecursiveBacktrackerStrategy<T, D, Topo>::loadState(std::istream& in) {
+  unsigned int size = readCheckpointValue<unsigned int>(in);
+  if (size > this->g->num_cells) {
+    throw CheckpointException();
+  }
+  // within the capacity reserved up front, so this does not allocate.
+  this->stack.resize(size);
+  readCheckpointBytes(in, this->stack.data(), size * sizeof(unsigned int));
+  for (auto& id : this->stack) {
+    if (id >= this->g->num_cells) {
+      throw CheckpointException();
+    }
+  }
+  if (!this->stack.empty()) {
+    this->current_cell = this->stack.back();
+  }
+  this->rng.loadState(in);
+}
@@ -0,0 +1,41 @@
+#ifndef REGION_GENERATION_H
+#define REGION_GENERATION_H
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "grid.h"
+#include "rng.h"
+#include "step-result.h"
+
+/* Region Generation Overview
+ *
+ * Generates a whole grid at once on several cores. The grid is cut into
+ * bands of whole rows, one band per region, and each region is carved into
+ * a perfect maze of its own, on its own thread, with its own stream split
+ * from the generator handed in:
+ *
+ *   rows 0 .. a-1     region 0, on thread 0
+ *   rows a .. b-1     region 1, on thread 1
+ *   ...
+ *
+ * Each region works on a grid of its own, so the workers share nothing.
+ * Once they are all done their passages are merged into the grid in one
+ * trusted batch per region, and a single passage is opened across each
+ * seam between neighboring bands. A tree per region joined by one edge per
+ * seam is still a tree, so the maze stays perfect.
+ *
+ * Band heights are a multiple of the topology's number of row parities, so
+ * a band's grid lines up with the rows it covers in the whole grid.
+ *
+ * Strategy is a generation strategy template, taking the grid and an Rng,
+ * such as HuntAndKillStrategy. Generating in regions returns the number of
+ * regions used, which is fewer than asked for when the grid is too short.
+ * */
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+unsigned int generateInRegions(Grid<T, D, Topo>* g, unsigned int num_regions,
+                               Rng rng);
+#include "region-generation_impl.h"
+#endif
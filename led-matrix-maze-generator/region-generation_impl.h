@@ -0,0 +1,76 @@
+template <template <class, class, class> class Strategy, class T, class D,
+          class Topo>
+unsigned int generateInRegions(Grid<T, D, Topo>* g, unsigned int num_regions,
+                               Rng rng) {
+  using RegionGrid = Grid<T, DynamicDimensions, Topo>;
+  using Edge = std::tuple<unsigned int, unsigned int>;
+
+  // split the rows into bands, in whole multiples of the row parities.
+  const unsigned int unit = Topo::num_parities;
+  const unsigned int num_units = g->num_rows / unit;
+  if (num_regions > num_units) {
+    num_regions = num_units;
+  }
+  if (num_regions == 0) {
+    num_regions = 1;
+  }
+  std::vector<unsigned int> first_rows;
+  for (unsigned int k = 0; k < num_regions; k++) {
+    first_rows.push_back((k * num_units / num_regions) * unit);
+  }
+  first_rows.push_back(g->num_rows);
+
+  // carve each region on a thread of its own.
+  std::vector<std::unique_ptr<RegionGrid>> regions;
+  std::vector<std::thread> workers;
+  for (unsigned int k = 0; k < num_regions; k++) {
+    regions.emplace_back(
+        new RegionGrid(first_rows[k + 1] - first_rows[k], g->num_cols));
+    workers.emplace_back(
+        [](RegionGrid* region, Rng region_rng) {
+          Strategy<T, DynamicDimensions, Topo> strategy(region, region_rng);
+          while (strategy.step().status != STEP_COMPLETE) {
+          }
+        },
+        regions.back().get(), rng.split());
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // merge each region's passages and cells into the grid.
+  std::vector<Edge> passages;
+  for (unsigned int k = 0; k < num_regions; k++) {
+    RegionGrid& region = *regions[k];
+    const unsigned int offset = first_rows[k] * g->num_cols;
+    passages.clear();
+    for (unsigned int id = 0; id < region.num_cells; id++) {
+      for (auto& neighbor : region.getNeighborsMatching(id, CONNECTED)) {
+        if (neighbor > id) {
+          passages.push_back(Edge(id + offset, neighbor + offset));
+        }
+      }
+      g->setCell(id + offset, region.getCell(id));
+    }
+    // both ends are neighbors in the region, so they are in the grid too.
+    g->modifyConnections(passages.begin(), passages.end(), CONNECTED,
+                         TRUSTED);
+  }
+
+  // open one passage across each seam, from a random cell of the first row
+  // above the seam to one of its neighbors below it. rows count up from the
+  // bottom, so the cells below the seam have the lower ids.
+  for (unsigned int k = 1; k < num_regions; k++) {
+    const unsigned int row = first_rows[k];
+    const unsigned int col = rng.below(g->num_cols);
+    const unsigned int id = g->getIdFromRowCol({row, col});
+    NeighborList below;
+    for (auto& neighbor : g->getNeighborsMatching(id, CONNECTABLE)) {
+      if (neighbor < row * g->num_cols) {
+        below.push_back(neighbor);
+      }
+    }
+    g->modifyConnection(id, below.at(rng.below(below.size())), CONNECTED);
+  }
+  return num_regions;
+}
@@ -0,0 +1,34 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+#include <memory>
+
+#include "cell.h"
+#include "generation-log.h"
+#include "grid.h"
+#include "step-result.h"
+
+/* ReplayStrategy Overview
+ *
+ * A generation strategy that makes no choices of its own, it plays back a
+ * GenerationLog recorded elsewhere, one logged step per step. Creating it
+ * plays back step 0, just as creating the recorded strategy changed its
+ * grid, so a Maze animating a replay looks exactly like one animating the
+ * strategy itself, while the work of generating was done ahead of time.
+ *
+ * The log is shared rather than copied, it is read only once recorded. It
+ * must have been recorded on a grid of the same size, anything else is
+ * thrown as misuse of the grid.
+ * */
+template <typename T = Cell, typename D = DynamicDimensions,
+          typename Topo = OrthogonalTopology>
+struct ReplayStrategy {
+  using LogPtr = std::shared_ptr<const GenerationLog<T>>;
+  Grid<T, D, Topo>* g;
+  LogPtr log;
+  // the logged step the next step plays back.
+  unsigned int next_step;
+  ReplayStrategy(Grid<T, D, Topo>* grid, LogPtr l);
+  StepResult step();
+};
+#include "replay_impl.h"
+#endif
@@ -0,0 +1,19 @@
+template <typename T, typename D, typename Topo>
+ReplayStrategy<T, D, Topo>::ReplayStrategy(Grid<T, D, Topo>* grid, LogPtr l)
+    : g(grid), log(l), next_step(0) {
+  if (this->log == nullptr || this->log->numRows() != this->g->num_rows ||
+      this->log->numCols() != this->g->num_cols) {
+    throw "The generation log was not recorded on a grid of this size.";
+  }
+  if (this->log->numSteps() > 0) {
+    this->log->replayStep(this->next_step++, this->g);
+  }
+}
+
+template <typename T, typename D, typename Topo>
+StepResult ReplayStrategy<T, D, Topo>::step() {
+  if (this->next_step >= this->log->numSteps()) {
+    return StepResult{STEP_COMPLETE, 0};
+  }
+  return this->log->replayStep(this->next_step++, this->g);
+}
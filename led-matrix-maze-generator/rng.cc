@@ -0,0 +1,98 @@
+#include "rng.h"
+
+#include <random>
+
+#include "checkpoint.h"
+
+static inline uint32_t rotl(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+static inline uint64_t splitmix64(uint64_t& x) {
+  uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+Rng::Rng() {
+  std::random_device entropy;
+  *this = Rng((uint64_t(entropy()) << 32) | entropy());
+}
+
+Rng::Rng(uint64_t seed) {
+  uint64_t a = splitmix64(seed);
+  uint64_t b = splitmix64(seed);
+  this->s[0] = uint32_t(a);
+  this->s[1] = uint32_t(a >> 32);
+  this->s[2] = uint32_t(b);
+  this->s[3] = uint32_t(b >> 32);
+}
+
+uint32_t Rng::next() {
+  const uint32_t result = rotl(this->s[0] + this->s[3], 7) + this->s[0];
+  const uint32_t t = this->s[1] << 9;
+  this->s[2] ^= this->s[0];
+  this->s[3] ^= this->s[1];
+  this->s[1] ^= this->s[2];
+  this->s[0] ^= this->s[3];
+  this->s[2] ^= t;
+  this->s[3] = rotl(this->s[3], 11);
+  return result;
+}
+
+uint64_t Rng::next64() {
+  const uint64_t low = this->next();
+  return low | (uint64_t(this->next()) << 32);
+}
+
+uint32_t Rng::below(uint32_t bound) {
+  uint64_t m = uint64_t(this->next()) * bound;
+  uint32_t low = uint32_t(m);
+  if (low < bound) {
+    // draws below this threshold would make some results more likely.
+    const uint32_t threshold = -bound % bound;
+    while (low < threshold) {
+      m = uint64_t(this->next()) * bound;
+      low = uint32_t(m);
+    }
+  }
+  return m >> 32;
+}
+
+void Rng::jump() {
+  static const uint32_t jump_poly[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3,
+                                       0x77f2db5b};
+  uint32_t j[4] = {0, 0, 0, 0};
+  for (auto poly : jump_poly) {
+    for (int b = 0; b < 32; b++) {
+      if (poly & (uint32_t(1) << b)) {
+        for (int i = 0; i < 4; i++) {
+          j[i] ^= this->s[i];
+        }
+      }
+      this->next();
+    }
+  }
+  for (int i = 0; i < 4; i++) {
+    this->s[i] = j[i];
+  }
+}
+
+Rng Rng::split() {
+  Rng child = *this;
+  this->jump();
+  return child;
+}
+
+void Rng::saveState(std::ostream& out) const {
+  writeCheckpointBytes(out, this->s, sizeof(this->s));
+}
+
+void Rng::loadState(std::istream& in) {
+  readCheckpointBytes(in, this->s, sizeof(this->s));
+  if ((this->s[0] | this->s[1] | this->s[2] | this->s[3]) == 0) {
+    // an all zero state would only ever produce zeros.
+    throw CheckpointException();
+  }
+}
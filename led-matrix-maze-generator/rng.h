@@ -0,0 +1,58 @@
+#ifndef RNG_H
+#define RNG_H
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+/* Rng Overview
+ *
+ * Rng is a small, fast pseudo random number generator, owned by whatever
+ * needs random numbers, so generation can be reproduced from a seed and
+ * generators on different threads never share state.
+ *
+ * The generator is xoshiro128++, which keeps 128 bits of state in four 32
+ * bit words, cheap to step on 32 bit boards. Seeds are expanded into the
+ * state with splitmix64.
+ *
+ * below(n) draws a value in [0, n) without the bias of taking rand() % n,
+ * using Lemire's multiply and reject method, which only divides when a draw
+ * lands in the small biased range.
+ *
+ * split() hands out a generator for an independent stream: the child takes
+ * the current state and the parent jumps 2^64 draws ahead, so streams never
+ * overlap in practice. Splitting the same seeded generator in the same
+ * order always hands out the same streams.
+ * */
+class Rng {
+  uint32_t s[4];
+
+ public:
+  // satisfies UniformRandomBitGenerator, so it works with <algorithm>.
+  using result_type = uint32_t;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  // seed from the system's entropy source.
+  Rng();
+  // seed for a reproducible stream.
+  explicit Rng(uint64_t seed);
+
+  // the next 32 random bits.
+  uint32_t next();
+  result_type operator()() { return this->next(); }
+  // the next 64 random bits, two draws, the first in the low half.
+  uint64_t next64();
+  // a value in [0, bound), bound must not be 0.
+  uint32_t below(uint32_t bound);
+  // advance the state 2^64 draws.
+  void jump();
+  // a generator for an independent stream, see the overview.
+  Rng split();
+  // write or read the state to a checkpoint.
+  void saveState(std::ostream&) const;
+  void loadState(std::istream&);
+};
+#endif
@@ -0,0 +1,138 @@
+#include "row-bitboards.h"
+
+#include <algorithm>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#include "footprint.h"
+
+RowBitboards::RowBitboards(unsigned int num_rows, unsigned int num_cols)
+    : num_rows(num_rows),
+      num_cols(num_cols),
+      words_per_row((num_cols + bits_per_word - 1) / bits_per_word),
+      east(num_rows * words_per_row, 0),
+      up(num_rows * words_per_row, 0),
+      column_mask(words_per_row, 0),
+      east_mask(words_per_row, 0) {
+  for (unsigned int col = 0; col < num_cols; col++) {
+    const Word bit = Word(1) << (col % bits_per_word);
+    this->column_mask[col / bits_per_word] |= bit;
+    if (col + 1 < num_cols) {
+      this->east_mask[col / bits_per_word] |= bit;
+    }
+  }
+}
+
+bool RowBitboards::hasEast(unsigned int row, unsigned int col) const {
+  return (this->eastRow(row)[col / bits_per_word] >> (col % bits_per_word)) &
+         1;
+}
+
+bool RowBitboards::hasUp(unsigned int row, unsigned int col) const {
+  return (this->upRow(row)[col / bits_per_word] >> (col % bits_per_word)) & 1;
+}
+
+const RowBitboards::Word* RowBitboards::eastRow(unsigned int row) const {
+  return &this->east.at(row * this->words_per_row);
+}
+
+const RowBitboards::Word* RowBitboards::upRow(unsigned int row) const {
+  return &this->up.at(row * this->words_per_row);
+}
+
+void RowBitboards::flipEastCoins(unsigned int row, Rng& rng) {
+  Word* e = &this->east.at(row * this->words_per_row);
+  Word* u = &this->up.at(row * this->words_per_row);
+  for (unsigned int w = 0; w < this->words_per_row; w++) {
+    e[w] = rng.next64();
+    u[w] = 0;
+  }
+  unsigned int w = 0;
+#ifdef __ARM_NEON
+  for (; w + 2 <= this->words_per_row; w += 2) {
+    vst1q_u64(e + w,
+              vandq_u64(vld1q_u64(e + w), vld1q_u64(&this->east_mask[w])));
+  }
+#endif
+  for (; w < this->words_per_row; w++) {
+    e[w] &= this->east_mask[w];
+  }
+}
+
+void RowBitboards::carveBinaryTreeRow(unsigned int row, Rng& rng) {
+  Word* e = &this->east.at(row * this->words_per_row);
+  Word* u = &this->up.at(row * this->words_per_row);
+  if (row + 1 == this->num_rows) {
+    // nothing above, so the top row is one long passage east.
+    std::copy(this->east_mask.begin(), this->east_mask.end(), e);
+    std::fill(u, u + this->words_per_row, 0);
+    return;
+  }
+  this->flipEastCoins(row, rng);
+  // every cell that did not open east opens up.
+  unsigned int w = 0;
+#ifdef __ARM_NEON
+  for (; w + 2 <= this->words_per_row; w += 2) {
+    vst1q_u64(u + w,
+              vbicq_u64(vld1q_u64(&this->column_mask[w]), vld1q_u64(e + w)));
+  }
+#endif
+  for (; w < this->words_per_row; w++) {
+    u[w] = this->column_mask[w] & ~e[w];
+  }
+}
+
+void RowBitboards::carveSidewinderRow(unsigned int row, Rng& rng) {
+  if (row + 1 == this->num_rows) {
+    // the top row is the same single run either way.
+    this->carveBinaryTreeRow(row, rng);
+    return;
+  }
+  this->flipEastCoins(row, rng);
+  const Word* e = this->eastRow(row);
+  Word* u = &this->up.at(row * this->words_per_row);
+  // a run ends at each column that did not open east, the last column
+  // always ends one.
+  unsigned int run_start = 0;
+  for (unsigned int w = 0; w < this->words_per_row; w++) {
+    for (Word ends = this->column_mask[w] & ~e[w]; ends != 0;
+         ends &= ends - 1) {
+      const unsigned int run_end = w * bits_per_word + __builtin_ctzll(ends);
+      const unsigned int col =
+          run_start + rng.below(run_end - run_start + 1);
+      u[col / bits_per_word] |= Word(1) << (col % bits_per_word);
+      run_start = run_end + 1;
+    }
+  }
+}
+
+void RowBitboards::carveBinaryTree(Rng& rng) {
+  for (unsigned int row = 0; row < this->num_rows; row++) {
+    this->carveBinaryTreeRow(row, rng);
+  }
+}
+
+void RowBitboards::carveSidewinder(Rng& rng) {
+  for (unsigned int row = 0; row < this->num_rows; row++) {
+    this->carveSidewinderRow(row, rng);
+  }
+}
+
+unsigned int RowBitboards::countPassages() const {
+  unsigned int total = 0;
+  for (auto& word : this->east) {
+    total += __builtin_popcountll(word);
+  }
+  for (auto& word : this->up) {
+    total += __builtin_popcountll(word);
+  }
+  return total;
+}
+
+size_t RowBitboards::footprint() const {
+  return storageFootprint(this->east) + storageFootprint(this->up) +
+         storageFootprint(this->column_mask) +
+         storageFootprint(this->east_mask);
+}
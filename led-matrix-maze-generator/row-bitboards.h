@@ -0,0 +1,89 @@
+#ifndef ROW_BITBOARDS_H
+#define ROW_BITBOARDS_H
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "grid.h"
+#include "rng.h"
+
+/* RowBitboards Overview
+ *
+ * The passages of an orthogonal maze kept as two bitboards per row of 64
+ * bit words, a bit per cell, so whole rows are carved and queried a word at
+ * a time rather than a cell at a time:
+ *
+ *   east   bit c of row r is set when cell (r, c) is open to (r, c + 1).
+ *   up     bit c of row r is set when cell (r, c) is open to (r + 1, c).
+ *
+ * Rows wider than 64 cells take several words, words_per_row of them, and
+ * the bits past the last column are always unset. This is also the packed
+ * export of a maze, 2 bits per cell, for runs that never need a Grid.
+ *
+ * Two row carvers are provided, each making a perfect maze when every row
+ * is carved once, in any order for the binary tree and bottom to top for
+ * sidewinder:
+ *
+ *   binary tree  each cell opens up or east on a coin flip, 64 flips per
+ *                random word. The top row can only open east, the last
+ *                column only up.
+ *   sidewinder   cells open east on a coin flip, which splits the row into
+ *                runs, and each run opens up from one random cell of it.
+ *                The top row is a single run that does not open up.
+ *
+ * Combining the random words with the column masks is done two words at a
+ * time with NEON where the compiler offers it, and a word at a time
+ * otherwise.
+ * */
+class RowBitboards {
+ public:
+  using Word = uint64_t;
+  static const unsigned int bits_per_word = 64;
+
+ private:
+  unsigned int num_rows;
+  unsigned int num_cols;
+  unsigned int words_per_row;
+  std::vector<Word> east;
+  std::vector<Word> up;
+  // the bits of each word of a row that are columns of the grid, and of
+  // those, the ones with a column to their east.
+  std::vector<Word> column_mask;
+  std::vector<Word> east_mask;
+  // fill the east words of a row with coin flips, masked to the columns
+  // that can open east, and clear its up words.
+  void flipEastCoins(unsigned int row, Rng& rng);
+
+ public:
+  RowBitboards(unsigned int num_rows, unsigned int num_cols);
+
+  unsigned int numRows() const { return this->num_rows; }
+  unsigned int numCols() const { return this->num_cols; }
+  unsigned int wordsPerRow() const { return this->words_per_row; }
+  bool hasEast(unsigned int row, unsigned int col) const;
+  bool hasUp(unsigned int row, unsigned int col) const;
+  // words of a row, words_per_row of each.
+  const Word* eastRow(unsigned int row) const;
+  const Word* upRow(unsigned int row) const;
+  // carve a single row, replacing whatever it held.
+  void carveBinaryTreeRow(unsigned int row, Rng& rng);
+  void carveSidewinderRow(unsigned int row, Rng& rng);
+  // carve every row, bottom to top.
+  void carveBinaryTree(Rng& rng);
+  void carveSidewinder(Rng& rng);
+  // number of open passages.
+  unsigned int countPassages() const;
+  // open the passages of a row in g, a grid of the same size with the
+  // orthogonal topology, in one trusted batch, and mark the row's cells
+  // visited. pairs is scratch space, kept by the caller between rows so
+  // this never allocates once it has grown.
+  template <class T, class D>
+  void exportRow(unsigned int row, Grid<T, D, OrthogonalTopology>* g,
+                 std::vector<std::tuple<unsigned int, unsigned int>>& pairs)
+      const;
+  // bytes allocated for the bitboards and masks.
+  size_t footprint() const;
+};
+#include "row-bitboards_impl.h"
+#endif
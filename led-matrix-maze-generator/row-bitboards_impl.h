@@ -0,0 +1,26 @@
+template <class T, class D>
+void RowBitboards::exportRow(
+    unsigned int row, Grid<T, D, OrthogonalTopology>* g,
+    std::vector<std::tuple<unsigned int, unsigned int>>& pairs) const {
+  pairs.clear();
+  const unsigned int first_id = row * this->num_cols;
+  const Word* east_words = this->eastRow(row);
+  const Word* up_words = this->upRow(row);
+  for (unsigned int w = 0; w < this->words_per_row; w++) {
+    const unsigned int base = first_id + w * bits_per_word;
+    // walk the set bits only, lowest first.
+    for (Word bits = east_words[w]; bits != 0; bits &= bits - 1) {
+      const unsigned int id = base + __builtin_ctzll(bits);
+      pairs.push_back(std::tuple<unsigned int, unsigned int>(id, id + 1));
+    }
+    for (Word bits = up_words[w]; bits != 0; bits &= bits - 1) {
+      const unsigned int id = base + __builtin_ctzll(bits);
+      pairs.push_back(
+          std::tuple<unsigned int, unsigned int>(id, id + this->num_cols));
+    }
+  }
+  g->modifyConnections(pairs.begin(), pairs.end(), CONNECTED, TRUSTED);
+  for (unsigned int col = 0; col < this->num_cols; col++) {
+    g->getCellRef(first_id + col).visited = true;
+  }
+}
@@ -0,0 +1,78 @@
+#ifndef ROW_CARVING_H
+#define ROW_CARVING_H
+#include <istream>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "cell.h"
+#include "checkpoint.h"
+#include "grid.h"
+#include "maze-exceptions.h"
+#include "rng.h"
+#include "row-bitboards.h"
+#include "step-result.h"
+
+/* RowCarvingStrategy Overview
+ *
+ * Carves a maze a row per step, from the bottom row up. Each row is carved
+ * as bitboards a word at a time by one of RowBitboards' row carvers, see
+ * row-bitboards.h, and then opened in the grid in one trusted batch, so a
+ * step costs a few instructions per 64 cells plus the batch.
+ *
+ * The carver is a template parameter, everything else (the row cursor,
+ * stepping and checkpoints) is shared:
+ *
+ *   BinaryTreeStrategy   each cell opens either up or east, on a coin flip,
+ *                        so every cell has exactly one way toward the top
+ *                        right corner. The mazes have a strong diagonal
+ *                        bias and the top row and last column are always
+ *                        straight corridors.
+ *   SidewinderStrategy   coin flips split the row into runs of cells opened
+ *                        east, and each run opens up from one random cell
+ *                        of it. The mazes have long horizontal passages and
+ *                        the top row is always a straight corridor, but no
+ *                        diagonal bias.
+ *
+ * Up and east only make sense with the orthogonal topology.
+ * */
+template <void (RowBitboards::*Carve)(unsigned int, Rng&), typename T = Cell,
+          typename D = DynamicDimensions, typename Topo = OrthogonalTopology>
+struct RowCarvingStrategy {
+  static_assert(std::is_same<Topo, OrthogonalTopology>::value,
+                "rows are carved up and east, which needs the orthogonal "
+                "topology.");
+  Grid<T, D, Topo>* g;
+  // every random choice is drawn from here, see rng.h.
+  Rng rng;
+  RowBitboards rows;
+  // the row the next step carves.
+  unsigned int next_row;
+  // scratch space for each row's passages, so stepping never allocates.
+  std::vector<std::tuple<unsigned int, unsigned int>> pairs;
+  RowCarvingStrategy(Grid<T, D, Topo>* grid, Rng r)
+      : g(grid), rng(r), rows(grid->num_rows, grid->num_cols), next_row(0) {
+    this->pairs.reserve(2 * grid->num_cols);
+  };
+  // without a generator, one is seeded from the system.
+  RowCarvingStrategy(Grid<T, D, Topo>* grid)
+      : RowCarvingStrategy(grid, Rng()){};
+  StepResult step();
+  // write or read the next row, and the state of the generator, to a
+  // checkpoint.
+  void saveState(std::ostream&);
+  void loadState(std::istream&);
+};
+
+template <typename T = Cell, typename D = DynamicDimensions,
+          typename Topo = OrthogonalTopology>
+using BinaryTreeStrategy =
+    RowCarvingStrategy<&RowBitboards::carveBinaryTreeRow, T, D, Topo>;
+
+template <typename T = Cell, typename D = DynamicDimensions,
+          typename Topo = OrthogonalTopology>
+using SidewinderStrategy =
+    RowCarvingStrategy<&RowBitboards::carveSidewinderRow, T, D, Topo>;
+#include "row-carving_impl.h"
+#endif
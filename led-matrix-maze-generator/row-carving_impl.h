@@ -0,0 +1,29 @@
+template <void (RowBitboards::*Carve)(unsigned int, Rng&), typename T,
+          typename D, typename Topo>
+StepResult RowCarvingStrategy<Carve, T, D, Topo>::step() {
+  if (this->next_row >= this->g->num_rows) {
+    return StepResult{STEP_COMPLETE, 0};
+  }
+  (this->rows.*Carve)(this->next_row, this->rng);
+  this->rows.exportRow(this->next_row, this->g, this->pairs);
+  this->next_row++;
+  return StepResult{STEP_CONTINUE, 0.05};
+}
+
+template <void (RowBitboards::*Carve)(unsigned int, Rng&), typename T,
+          typename D, typename Topo>
+void RowCarvingStrategy<Carve, T, D, Topo>::saveState(std::ostream& out) {
+  writeCheckpointValue<unsigned int>(out, this->next_row);
+  this->rng.saveState(out);
+}
+
+template <void (RowBitboards::*Carve)(unsigned int, Rng&), typename T,
+          typename D, typename Topo>
+void RowCarvingStrategy<Carve, T, D, Topo>::loadState(std::istream& in) {
+  // rows already carved are in the grid, only the next one matters.
+  this->next_row = readCheckpointValue<unsigned int>(in);
+  if (this->next_row > this->g->num_rows) {
+    throw CheckpointException();
+  }
+  this->rng.loadState(in);
+}
@@ -0,0 +1,70 @@
+#ifndef SCROLLING_MAZE_H
+#define SCROLLING_MAZE_H
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "double-buffered-canvas.h"
+#include "eller.h"
+#include "footprint.h"
+#include "led-matrix.h"
+#include "rng.h"
+
+/* ScrollingMaze Overview
+ *
+ * An endless maze which scrolls up the canvas, a pixel row at a time, with
+ * new rows generated at the bottom by an EllerRowGenerator. Nothing is
+ * kept of the maze but the rows on screen, so it runs in constant memory
+ * however long it scrolls.
+ *
+ * Each row of cells is two rows of pixels, laid out like Maze lays out a
+ * grid:
+ *
+ *   cell row      a cell every other pixel, with the east passages
+ *                 between them.
+ *   passage row   the south passages, below their cells.
+ *
+ * The visible rows are kept in a ring with one spare row. A scroll writes
+ * the new row into the spare slot and moves the top of the ring down by
+ * one, so nothing is copied. The canvas has no way to shift what it shows,
+ * so each pixel is compared with the one which was on screen at its
+ * position before the scroll, and only the pixels which changed are set.
+ * */
+template <typename T3 = rgb_matrix::Canvas>
+class ScrollingMaze {
+ public:
+  using Pixel = std::tuple<unsigned int, unsigned int, unsigned int>;
+  // each pixel is either a wall or part of the maze.
+  using PixelRow = std::vector<uint8_t>;
+  static const int distance_between_pixels = 2;
+
+ private:
+  Pixel wall_color = {0, 0, 0};
+  Pixel connected_color = {0, 255, 0};
+  unsigned int height;
+  unsigned int width;
+  T3* canvas;
+  EllerRowGenerator rows;
+  // visible rows and one spare, top is the slot shown at the top.
+  std::vector<PixelRow> ring;
+  unsigned int top;
+  // the second pixel row of the last cell row, while it waits its turn.
+  PixelRow pending;
+  bool has_pending;
+  PixelRow& slot(unsigned int);
+  void fillCellRow(PixelRow&);
+  void fillPassageRow(PixelRow&);
+  void drawDifferences();
+
+ public:
+  ScrollingMaze(T3* c, Rng rng);
+
+  // scroll up by one row of pixels, drawing the pixels that change.
+  void scroll();
+  // the row of pixels shown at row y of the canvas.
+  const PixelRow& visibleRow(unsigned int y);
+  // bytes held by the rows and the generator.
+  size_t footprint();
+};
+#include "scrolling-maze_impl.h"
+#endif
@@ -0,0 +1,101 @@
+template <typename T3>
+ScrollingMaze<T3>::ScrollingMaze(T3* c, Rng rng)
+    : height(c->height()),
+      width(c->width()),
+      canvas(c),
+      rows(c->width() / distance_between_pixels, rng),
+      ring(c->height() + 1, PixelRow(c->width(), 0)),
+      top(0),
+      pending(c->width(), 0),
+      has_pending(false) {
+  // the maze scrolls in from the bottom of an empty canvas.
+  const auto [r, g, b] = this->wall_color;
+  for (unsigned int y = 0; y < this->height; y++) {
+    for (unsigned int x = 0; x < this->width; x++) {
+      this->canvas->SetPixel(x, y, r, g, b);
+    }
+  }
+  presentFrame(this->canvas);
+}
+
+template <typename T3>
+typename ScrollingMaze<T3>::PixelRow& ScrollingMaze<T3>::slot(
+    unsigned int y) {
+  return this->ring[(this->top + y) % this->ring.size()];
+}
+
+template <typename T3>
+void ScrollingMaze<T3>::fillCellRow(PixelRow& row) {
+  for (unsigned int x = 0; x < this->width; x++) {
+    const unsigned int col = x / distance_between_pixels;
+    if (col >= this->rows.numCols()) {
+      row[x] = 0;
+    } else if (x % distance_between_pixels == 0) {
+      row[x] = 1;
+    } else {
+      row[x] = this->rows.east(col);
+    }
+  }
+}
+
+template <typename T3>
+void ScrollingMaze<T3>::fillPassageRow(PixelRow& row) {
+  for (unsigned int x = 0; x < this->width; x++) {
+    const unsigned int col = x / distance_between_pixels;
+    if (col < this->rows.numCols() && x % distance_between_pixels == 0) {
+      row[x] = this->rows.south(col);
+    } else {
+      row[x] = 0;
+    }
+  }
+}
+
+template <typename T3>
+void ScrollingMaze<T3>::drawDifferences() {
+  // row y now shows what row y + 1 showed before the scroll.
+  for (unsigned int y = 0; y < this->height; y++) {
+    const PixelRow& now = this->slot(y);
+    const PixelRow& before = this->slot(y + this->ring.size() - 1);
+    for (unsigned int x = 0; x < this->width; x++) {
+      if (now[x] == before[x]) {
+        continue;
+      }
+      const auto [r, g, b] = now[x] ? this->connected_color : this->wall_color;
+      this->canvas->SetPixel(x, y, r, g, b);
+    }
+  }
+  presentFrame(this->canvas);
+}
+
+template <typename T3>
+void ScrollingMaze<T3>::scroll() {
+  // the spare slot, just below the bottom of the canvas.
+  PixelRow& incoming = this->slot(this->height);
+  if (this->has_pending) {
+    incoming.swap(this->pending);
+    this->has_pending = false;
+  } else {
+    this->rows.nextRow();
+    this->fillCellRow(incoming);
+    this->fillPassageRow(this->pending);
+    this->has_pending = true;
+  }
+  this->top = (this->top + 1) % this->ring.size();
+  this->drawDifferences();
+}
+
+template <typename T3>
+const typename ScrollingMaze<T3>::PixelRow& ScrollingMaze<T3>::visibleRow(
+    unsigned int y) {
+  return this->slot(y);
+}
+
+template <typename T3>
+size_t ScrollingMaze<T3>::footprint() {
+  size_t total = storageFootprint(this->ring) +
+                 storageFootprint(this->pending) + this->rows.footprint();
+  for (const auto& row : this->ring) {
+    total += storageFootprint(row);
+  }
+  return total;
+}
@@ -0,0 +1,33 @@
+#ifndef SEGMENT_RASTERIZER_H
+#define SEGMENT_RASTERIZER_H
+#include <cstdlib>
+
+// rasterizeSegment hands visit(x, y) every pixel of the line segment from
+// (x1, y1) to (x2, y2), both ends included, starting from (x1, y1). Pixels
+// are picked with Bresenham's line algorithm, so horizontal, vertical and
+// diagonal segments (the passages of every topology) come out exact, in
+// either direction and for any distance between cells, and any other
+// segment comes out as the closest run of pixels. Each step moves along
+// one or both axes, chosen with arithmetic on the error term rather than
+// with branches, and nothing is thrown.
+template <class Visit>
+void rasterizeSegment(int x1, int y1, int x2, int y2, Visit visit) {
+  const int dx = std::abs(x2 - x1);
+  const int dy = -std::abs(y2 - y1);
+  const int sx = x1 < x2 ? 1 : -1;
+  const int sy = y1 < y2 ? 1 : -1;
+  int err = dx + dy;
+  int x = x1;
+  int y = y1;
+  // one pixel per step along the longer axis.
+  for (int steps = dx > -dy ? dx : -dy; steps >= 0; steps--) {
+    visit(x, y);
+    const int e2 = 2 * err;
+    const int step_x = e2 >= dy;
+    const int step_y = e2 <= dx;
+    err += step_x * dy + step_y * dx;
+    x += step_x * sx;
+    y += step_y * sy;
+  }
+}
+#endif
@@ -0,0 +1,96 @@
+#ifndef SHARDED_MAZE_H
+#define SHARDED_MAZE_H
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "cell.h"
+#include "led-matrix.h"
+#include "maze.h"
+#include "panel-canvas.h"
+#include "rng.h"
+
+/* ShardedMaze Overview
+ *
+ * A chain of panels is split into one shard per panel. Each shard is a Maze
+ * of its own, with its own Grid and generation strategy, drawing on its
+ * panel through a PanelCanvas. Generation runs one worker thread per shard,
+ * so a long chain takes about as long to fill as a single panel.
+ *
+ * Each shard generates a perfect maze of its own panel. Once every shard is
+ * done, a stitching pass opens exactly one passage across each seam between
+ * neighboring panels, which keeps the whole chain a perfect maze. A seam's
+ * passage joins the cell at the end of its row in the shard to the west to
+ * the cell at the start of the same row in the shard to the east:
+ *
+ *          shard k           shard k + 1
+ *   ... | 30 | 31 | ->    <- | 0 | 1 | ...    row of seam k
+ *
+ * Each end is kept as an exit in its own shard's grid (see grid.h), so it
+ * counts toward the shard's degrees, is drawn through the shard's pixel map
+ * and is kept when the shard is redrawn or checkpointed. The row of each
+ * opening depends only on the seam's position, so the stitch is the same
+ * every run:
+ *
+ *   row of seam k = (2k + 1) * rows / (2 * number of seams)
+ *
+ * which spreads the openings evenly down the chain.
+ * */
+template <typename T1, typename T2 = Cell, typename T3 = rgb_matrix::Canvas,
+          typename D = DynamicDimensions, typename Topo = OrthogonalTopology>
+class ShardedMaze {
+  static_assert(std::is_same<Topo, OrthogonalTopology>::value,
+                "seams are opened between the last and first columns of a "
+                "row, which needs the orthogonal topology.");
+
+ public:
+  using Shard = Maze<T1, T2, PanelCanvas<T3>, D, Topo>;
+  // the passage across the seam between shards k and k + 1, as the cell at
+  // each end, in its own shard.
+  struct Seam {
+    unsigned int row;
+    unsigned int west_cell;
+    unsigned int east_cell;
+  };
+  bool generated;
+
+ private:
+  T3* canvas;
+  std::mutex canvas_lock;
+  unsigned int panel_width;
+  // panels and shards are never moved once made, the shards keep pointers
+  // to their panels and their strategies keep pointers to their grids.
+  std::vector<std::unique_ptr<PanelCanvas<T3>>> panels;
+  std::vector<std::unique_ptr<Shard>> shards;
+  std::vector<Seam> seams;
+  std::vector<Seam> initSeams();
+  void initPanels();
+  void runShard(unsigned int, const std::atomic<bool>&, float);
+  void stitch();
+
+ public:
+  ShardedMaze(T3* c, unsigned int panel_width);
+  // each shard's strategy gets its own stream split from rng, in panel
+  // order, so the same seed always gives the same chain no matter how the
+  // threads are scheduled.
+  ShardedMaze(T3* c, unsigned int panel_width, Rng rng);
+
+  // generate every shard on its own thread, then stitch them together.
+  // returns early, without stitching, once interrupt is set. the delay each
+  // strategy asks for between steps is multiplied by time_scale, 0 runs
+  // flat out.
+  void generate(const std::atomic<bool>& interrupt, float time_scale = 1);
+  unsigned int numShards();
+  Shard& getShard(unsigned int);
+  // row of the grid, shared by both shards, where seam k (between shards k
+  // and k + 1) is opened.
+  unsigned int getSeamRow(unsigned int);
+  const Seam& getSeam(unsigned int);
+  // bytes held by all of the shards together, now and at their peaks.
+  MazeFootprint footprint();
+  MazeFootprint peakFootprint();
+};
+#include "sharded-maze_impl.h"
+#endif
@@ -0,0 +1,146 @@
+#include <chrono>
+#include <thread>
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+ShardedMaze<T1, T2, T3, D, Topo>::ShardedMaze(T3* c, unsigned int panel_width)
+    : generated(false), canvas(c), panel_width(panel_width) {
+  this->initPanels();
+  for (auto& panel : this->panels) {
+    this->shards.emplace_back(new Shard(panel.get()));
+  }
+  this->seams = this->initSeams();
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+ShardedMaze<T1, T2, T3, D, Topo>::ShardedMaze(T3* c, unsigned int panel_width,
+                                              Rng rng)
+    : generated(false), canvas(c), panel_width(panel_width) {
+  this->initPanels();
+  for (auto& panel : this->panels) {
+    this->shards.emplace_back(new Shard(panel.get(), rng.split()));
+  }
+  this->seams = this->initSeams();
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void ShardedMaze<T1, T2, T3, D, Topo>::initPanels() {
+  if (this->panel_width == 0 ||
+      this->canvas->width() % this->panel_width != 0) {
+    throw "Canvas width must be a whole number of panels.";
+  }
+  const unsigned int num_panels = this->canvas->width() / this->panel_width;
+  for (unsigned int i = 0; i < num_panels; i++) {
+    this->panels.emplace_back(
+        new PanelCanvas<T3>(this->canvas, &this->canvas_lock,
+                            i * this->panel_width, this->panel_width));
+  }
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+std::vector<typename ShardedMaze<T1, T2, T3, D, Topo>::Seam>
+ShardedMaze<T1, T2, T3, D, Topo>::initSeams() {
+  const unsigned int num_rows =
+      this->canvas->height() / Shard::distance_between_pixels;
+  const unsigned int num_cols =
+      this->panel_width / Shard::distance_between_pixels;
+  const unsigned int num_seams = this->shards.size() - 1;
+  std::vector<Seam> seams;
+  for (unsigned int k = 0; k < num_seams; k++) {
+    const unsigned int row = ((2 * k + 1) * num_rows) / (2 * num_seams);
+    seams.push_back(
+        Seam{row, row * num_cols + num_cols - 1, row * num_cols});
+  }
+  return seams;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void ShardedMaze<T1, T2, T3, D, Topo>::runShard(
+    unsigned int k, const std::atomic<bool>& interrupt, float time_scale) {
+  Shard& shard = *this->shards[k];
+  while (!interrupt && !shard.generated) {
+    float sleep_time_secs = shard.generateStep();
+    shard.updatePixelMap();
+    if (time_scale > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::duration<float>(sleep_time_secs * time_scale));
+    }
+  }
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void ShardedMaze<T1, T2, T3, D, Topo>::stitch() {
+  for (unsigned int k = 0; k < this->seams.size(); k++) {
+    const Seam& seam = this->seams[k];
+    this->shards[k]->modifyExit(seam.west_cell, RIGHT, CONNECTED);
+    this->shards[k + 1]->modifyExit(seam.east_cell, LEFT, CONNECTED);
+  }
+  for (auto& shard : this->shards) {
+    shard->updatePixelMap();
+  }
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+void ShardedMaze<T1, T2, T3, D, Topo>::generate(
+    const std::atomic<bool>& interrupt, float time_scale) {
+  if (this->generated) {
+    throw GenerationCompleteException();
+  }
+
+  std::vector<std::thread> workers;
+  for (unsigned int k = 0; k < this->shards.size(); k++) {
+    workers.emplace_back(&ShardedMaze<T1, T2, T3, D, Topo>::runShard, this, k,
+                         std::ref(interrupt), time_scale);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (auto& shard : this->shards) {
+    if (!shard->generated) {
+      // interrupted, the seams are left closed.
+      return;
+    }
+  }
+  this->stitch();
+  this->generated = true;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+unsigned int ShardedMaze<T1, T2, T3, D, Topo>::numShards() {
+  return this->shards.size();
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+typename ShardedMaze<T1, T2, T3, D, Topo>::Shard&
+ShardedMaze<T1, T2, T3, D, Topo>::getShard(unsigned int k) {
+  return *this->shards.at(k);
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+unsigned int ShardedMaze<T1, T2, T3, D, Topo>::getSeamRow(unsigned int k) {
+  return this->seams.at(k).row;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+const typename ShardedMaze<T1, T2, T3, D, Topo>::Seam&
+ShardedMaze<T1, T2, T3, D, Topo>::getSeam(unsigned int k) {
+  return this->seams.at(k);
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+MazeFootprint ShardedMaze<T1, T2, T3, D, Topo>::footprint() {
+  MazeFootprint f;
+  for (auto& shard : this->shards) {
+    f += shard->footprint();
+  }
+  return f;
+}
+
+template <typename T1, typename T2, typename T3, typename D, typename Topo>
+MazeFootprint ShardedMaze<T1, T2, T3, D, Topo>::peakFootprint() {
+  MazeFootprint f;
+  for (auto& shard : this->shards) {
+    f += shard->peakFootprint();
+  }
+  return f;
+}
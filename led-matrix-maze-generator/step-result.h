@@ -0,0 +1,14 @@
+#ifndef STEP_RESULT_H
+#define STEP_RESULT_H
+
+// Generation strategies report the outcome of each step as a StepResult,
+// rather than throwing once there is nothing left to do. Exceptions are left
+// for misuse, such as stepping a maze that is already generated.
+enum StepStatus { STEP_CONTINUE, STEP_COMPLETE };
+
+struct StepResult {
+  StepStatus status;
+  // seconds to wait before the next step, so the generation can be watched.
+  float delay;
+};
+#endif
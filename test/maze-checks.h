@@ -0,0 +1,38 @@
+#ifndef MAZE_CHECKS_H
+#define MAZE_CHECKS_H
+#include <vector>
+
+#include "grid.h"
+
+// a perfect maze is a tree that reaches every cell, so it has exactly one
+// passage fewer than it has cells, and every cell can be reached from cell
+// 0. A grid with a cycle has more passages than that, or leaves some cell
+// unreached.
+template <class G>
+bool isPerfectMaze(G& g) {
+  unsigned int passages = 0;
+  for (unsigned int id = 0; id < g.num_cells; id++) {
+    passages += g.getNeighborsMatching(id, CONNECTED).size();
+  }
+  // every passage is counted from both ends.
+  if (passages != 2 * (g.num_cells - 1)) {
+    return false;
+  }
+  std::vector<bool> seen(g.num_cells, false);
+  std::vector<unsigned int> todo = {0};
+  seen[0] = true;
+  unsigned int reached = 0;
+  while (!todo.empty()) {
+    unsigned int id = todo.back();
+    todo.pop_back();
+    reached++;
+    for (auto& neighbor : g.getNeighborsMatching(id, CONNECTED)) {
+      if (!seen[neighbor]) {
+        seen[neighbor] = true;
+        todo.push_back(neighbor);
+      }
+    }
+  }
+  return reached == g.num_cells;
+}
+#endif
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "cell.h"
+#include "damage-tracker.h"
+#include "doctest.h"
+#include "hunt-and-kill.h"
+#include "maze.h"
+
+using Run = std::tuple<unsigned int, unsigned int, unsigned int>;
+
+static std::vector<Run> flushRuns(DamageTracker& damage) {
+  std::vector<Run> runs;
+  damage.flush([&runs](unsigned int row, unsigned int col, unsigned int n) {
+    runs.push_back(Run(row, col, n));
+  });
+  return runs;
+}
+
+// RunCanvas takes runs of pixels as well as single pixels, and counts both.
+struct RunCanvas {
+  unsigned int pixels = 0;
+  unsigned int runs = 0;
+  std::vector<std::tuple<int, int, int> > frame =
+      std::vector<std::tuple<int, int, int> >(64 * 64);
+  int width() { return 64; };
+  int height() { return 64; };
+  void SetPixel(int x, int y, int r, int g, int b) {
+    this->frame[y * 64 + x] = std::tuple<int, int, int>(r, g, b);
+    this->pixels++;
+  };
+  void SetPixelRun(int x, int y, const uint8_t* rgb, int count) {
+    for (int i = 0; i < count; i++, rgb += 3) {
+      this->frame[y * 64 + x + i] =
+          std::tuple<int, int, int>(rgb[0], rgb[1], rgb[2]);
+    }
+    this->runs++;
+  };
+};
+
+TEST_CASE("A damage tracker hands out runs of dirty pixels.") {
+  std::cout << "(A damage tracker hands out runs of dirty pixels)\n";
+
+  SUBCASE("Runs come out once each, in row and column order") {
+    std::cout << "  (Runs come out once each, in row and column order)\n";
+    DamageTracker damage(8, 10);
+    CHECK(damage.empty());
+    damage.mark(3, 7);
+    damage.mark(3, 2);
+    damage.mark(3, 3);
+    damage.mark(3, 4);
+    damage.mark(3, 3);
+    damage.mark(0, 9);
+    CHECK(damage.isDirty(3, 3));
+    CHECK(!damage.empty());
+    auto runs = flushRuns(damage);
+    REQUIRE(runs.size() == 3);
+    CHECK(runs[0] == Run(0, 9, 1));
+    CHECK(runs[1] == Run(3, 2, 3));
+    CHECK(runs[2] == Run(3, 7, 1));
+    CHECK(damage.empty());
+    CHECK(flushRuns(damage).empty());
+  }
+
+  SUBCASE("Runs never cross into the next row") {
+    std::cout << "  (Runs never cross into the next row)\n";
+    for (unsigned int cols : {64u, 70u, 128u}) {
+      DamageTracker damage(3, cols);
+      for (unsigned int col = 0; col < cols; col++) {
+        damage.mark(0, col);
+        damage.mark(1, col);
+      }
+      auto runs = flushRuns(damage);
+      REQUIRE(runs.size() == 2);
+      CHECK(runs[0] == Run(0, 0, cols));
+      CHECK(runs[1] == Run(1, 0, cols));
+    }
+  }
+
+  SUBCASE("Clearing drops everything") {
+    std::cout << "  (Clearing drops everything)\n";
+    DamageTracker damage(4, 4);
+    damage.mark(1, 1);
+    damage.clear();
+    CHECK(damage.empty());
+    CHECK(flushRuns(damage).empty());
+  }
+}
+
+TEST_CASE("A maze draws runs on canvases that take them.") {
+  std::cout << "(A maze draws runs on canvases that take them)\n";
+  RunCanvas* c = new RunCanvas;
+  Maze<HuntAndKillStrategy<>, Cell, RunCanvas> m(c, Rng(4));
+  // the whole map is a run per row.
+  CHECK(c->runs == 64);
+  CHECK(c->pixels == 0);
+  m.generateAll();
+  const auto& map = m.generatePixelMap();
+  m.updatePixelMap();
+  CHECK(c->pixels == 0);
+  for (unsigned int y = 0; y < 64; y++) {
+    for (unsigned int x = 0; x < 64; x++) {
+      const auto [r, g, b] = map[y][x];
+      CHECK(c->frame[y * 64 + x] == std::make_tuple(int(r), int(g), int(b)));
+    }
+  }
+  delete c;
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "cell.h"
+#include "doctest.h"
+#include "double-buffered-canvas.h"
+#include "hunt-and-kill.h"
+#include "maze.h"
+
+// StubFrame is an offscreen frame of 64x64 pixels.
+struct StubFrame {
+  std::vector<std::tuple<int, int, int> > pixels =
+      std::vector<std::tuple<int, int, int> >(64 * 64);
+  int width() { return 64; };
+  int height() { return 64; };
+  void SetPixel(int x, int y, int r, int g, int b) {
+    this->pixels[y * 64 + x] = std::tuple<int, int, int>(r, g, b);
+  };
+};
+
+// StubMatrix shows one of two frames, swapping them as the matrix library
+// does on vsync.
+struct StubMatrix {
+  StubFrame frames[2];
+  StubFrame* shown = &frames[0];
+  unsigned int swaps = 0;
+  StubFrame* CreateFrameCanvas() { return &frames[1]; }
+  StubFrame* SwapOnVSync(StubFrame* next) {
+    StubFrame* previous = this->shown;
+    this->shown = next;
+    this->swaps++;
+    return previous;
+  }
+};
+
+using StubCanvas = DoubleBufferedCanvas<StubMatrix, StubFrame>;
+
+TEST_CASE("A double buffered canvas only shows whole frames.") {
+  std::cout << "(A double buffered canvas only shows whole frames)\n";
+  StubMatrix matrix;
+  StubCanvas canvas(&matrix);
+
+  SUBCASE("Drawing changes nothing on show until the swap") {
+    std::cout << "  (Drawing changes nothing on show until the swap)\n";
+    canvas.SetPixel(1, 2, 255, 0, 0);
+    canvas.SetPixel(3, 4, 0, 255, 0);
+    CHECK(matrix.shown->pixels[2 * 64 + 1] == std::make_tuple(0, 0, 0));
+    CHECK(canvas.pendingWrites() == 2);
+    canvas.present();
+    CHECK(matrix.swaps == 1);
+    CHECK(matrix.shown->pixels[2 * 64 + 1] == std::make_tuple(255, 0, 0));
+    CHECK(matrix.shown->pixels[4 * 64 + 3] == std::make_tuple(0, 255, 0));
+    CHECK(canvas.pendingWrites() == 0);
+  }
+
+  SUBCASE("The new back frame catches up with the one on show") {
+    std::cout << "  (The new back frame catches up with the one on show)\n";
+    canvas.SetPixel(1, 2, 255, 0, 0);
+    canvas.present();
+    canvas.SetPixel(5, 5, 0, 0, 255);
+    canvas.present();
+    CHECK(matrix.frames[0].pixels == matrix.frames[1].pixels);
+    CHECK(matrix.shown->pixels[2 * 64 + 1] == std::make_tuple(255, 0, 0));
+  }
+
+  SUBCASE("Presenting with nothing drawn does not swap") {
+    std::cout << "  (Presenting with nothing drawn does not swap)\n";
+    canvas.present();
+    CHECK(matrix.swaps == 0);
+  }
+}
+
+TEST_CASE("A maze presents each frame it draws.") {
+  std::cout << "(A maze presents each frame it draws)\n";
+  StubMatrix matrix;
+  StubCanvas canvas(&matrix);
+  Maze<HuntAndKillStrategy<>, Cell, StubCanvas> m(&canvas, Rng(3));
+  // the initial map is one frame.
+  CHECK(matrix.swaps == 1);
+  CHECK(canvas.pendingWrites() == 0);
+
+  while (!m.generated) {
+    const unsigned int swaps = matrix.swaps;
+    m.generateStep();
+    m.updatePixelMap();
+    CHECK(matrix.swaps <= swaps + 1);
+    CHECK(canvas.pendingWrites() == 0);
+  }
+  // both frames hold the finished maze, as drawn.
+  CHECK(matrix.frames[0].pixels == matrix.frames[1].pixels);
+  const auto& map = m.generatePixelMap();
+  for (unsigned int y = 0; y < 64; y++) {
+    for (unsigned int x = 0; x < 64; x++) {
+      const auto [r, g, b] = map[y][x];
+      CHECK(matrix.shown->pixels[y * 64 + x] ==
+            std::make_tuple(int(r), int(g), int(b)));
+    }
+  }
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <vector>
+
+#include "doctest.h"
+#include "eller.h"
+#include "grid.h"
+#include "maze-checks.h"
+#include "scrolling-maze.h"
+
+// copy the passages of the last row into row r of g.
+static void addRow(Grid<bool>& g, EllerRowGenerator& rows, unsigned int r) {
+  for (unsigned int col = 0; col < rows.numCols(); col++) {
+    const unsigned int id = g.getIdFromRowCol({r, col});
+    if (col + 1 < rows.numCols() && rows.east(col)) {
+      g.modifyConnection(id, id + 1, CONNECTED);
+    }
+    if (r + 1 < g.num_rows && rows.south(col)) {
+      g.modifyConnection(id, id + g.num_cols, CONNECTED);
+    }
+  }
+}
+
+TEST_CASE("Eller's algorithm generates a maze a row at a time.") {
+  std::cout << "(Eller's algorithm generates a maze a row at a time)\n";
+  EllerRowGenerator rows(32, Rng(11));
+
+  SUBCASE("Closing the rows off gives a perfect maze") {
+    std::cout << "  (Closing the rows off gives a perfect maze)\n";
+    Grid<bool> g(24, 32);
+    for (unsigned int r = 0; r + 1 < g.num_rows; r++) {
+      rows.nextRow();
+      addRow(g, rows, r);
+    }
+    rows.lastRow();
+    addRow(g, rows, g.num_rows - 1);
+    CHECK(isPerfectMaze(g));
+  }
+
+  SUBCASE("Every row leads down to the next") {
+    std::cout << "  (Every row leads down to the next)\n";
+    for (int r = 0; r < 100; r++) {
+      rows.nextRow();
+      bool any_south = false;
+      for (unsigned int col = 0; col < rows.numCols(); col++) {
+        any_south = any_south || rows.south(col);
+      }
+      CHECK(any_south);
+    }
+  }
+
+  SUBCASE("Memory does not grow however many rows are made") {
+    std::cout << "  (Memory does not grow however many rows are made)\n";
+    rows.nextRow();
+    const size_t footprint = rows.footprint();
+    for (int r = 0; r < 10000; r++) {
+      rows.nextRow();
+    }
+    CHECK(rows.footprint() == footprint);
+  }
+}
+
+// a canvas which remembers what it shows.
+struct ScreenCanvas {
+  int w = 64;
+  int h = 64;
+  unsigned int pixels_set = 0;
+  std::vector<std::vector<int> > green;
+  ScreenCanvas() : green(64, std::vector<int>(64, -1)){};
+  int width() { return this->w; };
+  int height() { return this->h; };
+  void SetPixel(int x, int y, int r, int g, int b) {
+    this->green[y][x] = g;
+    this->pixels_set++;
+  };
+};
+
+TEST_CASE("An endless maze can be scrolled.") {
+  std::cout << "(An endless maze can be scrolled)\n";
+  ScreenCanvas* c = new ScreenCanvas;
+  ScrollingMaze<ScreenCanvas> m(c, Rng(4));
+  CHECK(c->pixels_set == 64 * 64);
+  const size_t footprint = m.footprint();
+
+  SUBCASE("The canvas shows the visible rows after each scroll") {
+    std::cout << "  (The canvas shows the visible rows after each scroll)\n";
+    for (int frame = 0; frame < 300; frame++) {
+      c->pixels_set = 0;
+      m.scroll();
+      // only the pixels that changed are set.
+      CHECK(c->pixels_set < 64 * 64);
+    }
+    for (unsigned int y = 0; y < 64; y++) {
+      const auto& row = m.visibleRow(y);
+      for (unsigned int x = 0; x < 64; x++) {
+        CHECK(c->green[y][x] == (row[x] ? 255 : 0));
+      }
+    }
+    CHECK(m.footprint() == footprint);
+  }
+  delete c;
+}
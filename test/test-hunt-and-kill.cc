@@ -1,6 +1,7 @@
 #include <time.h>
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
 #include "cell.h"
@@ -65,20 +66,135 @@ TEST_CASE("The hunt and kill strategy can be created.") {
     }
   }
 
-  SUBCASE(
-      "A user can call step until a generation complete exception is thrown") {
+  SUBCASE("A user can call step until it reports generation is complete") {
     std::vector<unsigned int> visited_cells;
     bool generated = false;
     visited_cells.push_back(strat.current_cell);
     while (!generated) {
-      try {
-        strat.step();
-        visited_cells.push_back(strat.current_cell);
-      } catch (GenerationCompleteException& e) {
+      if (strat.step().status == STEP_COMPLETE) {
         generated = true;
+      } else {
+        visited_cells.push_back(strat.current_cell);
       }
     }
     CHECK(generated);
     CHECK(visited_cells.size() == g.num_cells);
   }
 }
+
+TEST_CASE("The hunt and kill strategy works on a grid sized at compile time.") {
+  using Dims = StaticDimensions<16, 16>;
+  Grid<Cell, Dims> g;
+  HuntAndKillStrategy<Cell, Dims> strat(&g);
+  bool generated = false;
+  while (!generated) {
+    generated = strat.step().status == STEP_COMPLETE;
+  }
+  CHECK(g.getCells().countVisited() == g.num_cells);
+}
+
+TEST_CASE("The hunt and kill strategy works with other topologies.") {
+  Grid<Cell, DynamicDimensions, HexTopology> g(16, 16);
+  HuntAndKillStrategy<Cell, DynamicDimensions, HexTopology> strat(&g);
+  unsigned int connections = 0;
+  bool generated = false;
+  while (!generated) {
+    if (strat.step().status == STEP_COMPLETE) {
+      generated = true;
+    } else {
+      connections++;
+    }
+  }
+  // every cell is visited, and joined to the maze by exactly one passage.
+  CHECK(g.getCells().countVisited() == g.num_cells);
+  CHECK(connections == g.num_cells - 1);
+}
+
+TEST_CASE("The hunt and kill strategy keeps a frontier of huntable cells.") {
+  Grid<Cell> g(32, 32);
+  HuntAndKillStrategy<Cell> strat(&g);
+
+  SUBCASE("The frontier is the unvisited cells next to visited ones") {
+    for (int i = 0; i < 100; i++) {
+      if (strat.step().status == STEP_COMPLETE) {
+        break;
+      }
+    }
+    for (unsigned int id = 0; id < g.num_cells; id++) {
+      bool borders_visited = false;
+      for (auto& neighbor : g.getNeighborsMatching(id, CONNECTABLE)) {
+        borders_visited = borders_visited || g.getCell(neighbor).visited;
+      }
+      CHECK(strat.frontier.contains(id) ==
+            (!g.getCell(id).visited && borders_visited));
+    }
+  }
+
+  SUBCASE("A row cursor hunt picks the lowest frontier cell") {
+    bool can_walk = true;
+    while (can_walk) {
+      try {
+        strat.walk();
+      } catch (CantWalkException& e) {
+        can_walk = false;
+      }
+    }
+    if (!strat.frontier.empty()) {
+      unsigned int lowest = g.num_cells;
+      for (unsigned int i = 0; i < strat.frontier.size(); i++) {
+        lowest = std::min(lowest, strat.frontier.at(i));
+      }
+      strat.hunt();
+      CHECK(strat.current_cell == lowest);
+    }
+  }
+}
+
+TEST_CASE("A large grid is generated in either hunt mode.") {
+  for (auto mode : {HUNT_ROW_CURSOR, HUNT_RANDOM}) {
+    Grid<Cell> g(256, 256);
+    HuntAndKillStrategy<Cell> strat(&g, mode);
+    auto start = std::chrono::high_resolution_clock::now();
+    bool generated = false;
+    while (!generated) {
+      generated = strat.step().status == STEP_COMPLETE;
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    std::cout << "  generated a 256x256 maze hunting "
+              << (mode == HUNT_RANDOM ? "at random" : "by row") << " in "
+              << duration.count() << " milliseconds.\n";
+    CHECK(g.getCells().countVisited() == g.num_cells);
+    CHECK(strat.frontier.empty());
+  }
+}
+
+TEST_CASE("A generated maze reports completion without throwing.") {
+  Grid<Cell> g(8, 8);
+  HuntAndKillStrategy<Cell> strat(&g);
+  StepResult result{STEP_CONTINUE, 0};
+  while (result.status != STEP_COMPLETE) {
+    result = strat.step();
+  }
+  CHECK(result.delay == 0);
+  // stepping again keeps reporting completion.
+  CHECK(strat.step().status == STEP_COMPLETE);
+  CHECK(!strat.tryWalk());
+  CHECK(!strat.tryHunt());
+  CHECK_THROWS_AS(strat.hunt(), HuntFailedException);
+}
+
+TEST_CASE("The hunt and kill strategy can be reproduced from a seed.") {
+  auto generate = [](uint64_t seed) {
+    Grid<Cell> g(16, 16);
+    HuntAndKillStrategy<Cell> strat(&g, Rng(seed));
+    std::vector<unsigned int> path;
+    while (strat.step().status != STEP_COMPLETE) {
+      path.push_back(strat.current_cell);
+    }
+    return path;
+  };
+  CHECK(generate(1) == generate(1));
+  CHECK(generate(1) != generate(2));
+}
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include "cell.h"
+#include "doctest.h"
+#include "disjoint-sets.h"
+#include "kruskal.h"
+
+TEST_CASE("Disjoint sets can be created.") {
+  DisjointSets sets(10);
+
+  SUBCASE("Every id starts in a set of its own") {
+    for (unsigned int id = 0; id < 10; id++) {
+      CHECK(sets.find(id) == id);
+    }
+  }
+
+  SUBCASE("Uniting joins sets once") {
+    CHECK(sets.unite(0, 1));
+    CHECK(sets.unite(2, 3));
+    CHECK(sets.unite(1, 3));
+    CHECK(!sets.unite(0, 2));
+    CHECK(sets.find(0) == sets.find(3));
+    CHECK(sets.find(4) != sets.find(0));
+    sets.reset();
+    CHECK(sets.find(3) == 3);
+  }
+}
+
+TEST_CASE("The kruskal strategy can be created.") {
+  Grid<Cell> g(32, 32);
+  KruskalStrategy<Cell> strat(&g, Rng(8));
+
+  SUBCASE("Every pair of connectable neighbors is an edge") {
+    // 32 rows of 31 horizontal edges, and the same again vertically.
+    CHECK(strat.edges.size() == 2 * 32 * 31);
+  }
+
+  SUBCASE("Each step carves one passage, until the maze is a tree") {
+    auto start = std::chrono::high_resolution_clock::now();
+    unsigned int steps = 0;
+    while (strat.step().status != STEP_COMPLETE) {
+      steps++;
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "  generated a 32x32 maze with kruskal in " << duration.count()
+              << " microseconds.\n";
+    CHECK(steps == g.num_cells - 1);
+    CHECK(g.getCells().countVisited() == g.num_cells);
+    for (unsigned int id = 1; id < g.num_cells; id++) {
+      CHECK(strat.sets.find(id) == strat.sets.find(0));
+    }
+  }
+
+  SUBCASE("A checkpointed strategy carries on where it stopped") {
+    for (int i = 0; i < 200; i++) {
+      strat.step();
+    }
+    std::stringstream state;
+    strat.saveState(state);
+    Grid<Cell> copy(32, 32);
+    for (unsigned int id = 0; id < g.num_cells; id++) {
+      for (auto& neighbor : g.getNeighborsMatching(id, CONNECTED)) {
+        if (neighbor > id) {
+          copy.modifyConnection(id, neighbor, CONNECTED);
+        }
+      }
+    }
+    KruskalStrategy<Cell> resumed(&copy, Rng(99));
+    resumed.loadState(state);
+    CHECK(resumed.passages == 200);
+    while (strat.step().status != STEP_COMPLETE) {
+      CHECK(resumed.step().status == STEP_CONTINUE);
+    }
+    CHECK(resumed.step().status == STEP_COMPLETE);
+    for (unsigned int id = 0; id < g.num_cells; id++) {
+      CHECK(g.getCellIdsMatching(id, CONNECTED) ==
+            copy.getCellIdsMatching(id, CONNECTED));
+    }
+  }
+}
@@ -0,0 +1,263 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include "bounded-queue.h"
+#include "cell.h"
+#include "doctest.h"
+#include "hunt-and-kill.h"
+#include "maze-checks.h"
+#include "maze-producer.h"
+#include "maze.h"
+#include "recursive-backtracker.h"
+#include "replay.h"
+
+// FrameCanvas keeps the last color drawn at each pixel, and counts draws.
+struct FrameCanvas {
+  int w = 64;
+  int h = 64;
+  unsigned int draws = 0;
+  std::vector<std::tuple<int, int, int> > frame =
+      std::vector<std::tuple<int, int, int> >(64 * 64);
+  int width() { return this->w; };
+  int height() { return this->h; };
+  void SetPixel(int x, int y, int r, int g, int b) {
+    this->frame[y * this->w + x] = std::tuple<int, int, int>(r, g, b);
+    this->draws++;
+  };
+};
+
+using ReplayMaze = Maze<ReplayStrategy<>, Cell, FrameCanvas>;
+using Log = GenerationLog<Cell>;
+
+TEST_CASE("A generation log replays a strategy exactly.") {
+  std::cout << "(A generation log replays a strategy exactly)\n";
+  Grid<Cell> recorded(32, 32);
+  auto start = std::chrono::high_resolution_clock::now();
+  auto log = std::make_shared<const Log>(
+      Log::record<HuntAndKillStrategy>(&recorded, Rng(5)));
+  auto stop = std::chrono::high_resolution_clock::now();
+  auto duration =
+      std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+  std::cout << "  recorded a 32x32 maze in " << duration.count()
+            << " microseconds, " << log->footprint() << " bytes.\n";
+
+  SUBCASE("Replaying gives the same grid and results as generating") {
+    std::cout << "  (Replaying gives the same grid and results as "
+                 "generating)\n";
+    Grid<Cell> live(32, 32);
+    HuntAndKillStrategy<> strategy(&live, Rng(5));
+    Grid<Cell> replayed(32, 32);
+    ReplayStrategy<> replay(&replayed, log);
+    StepResult expected;
+    do {
+      expected = strategy.step();
+      StepResult got = replay.step();
+      CHECK(got.status == expected.status);
+      CHECK(got.delay == expected.delay);
+    } while (expected.status != STEP_COMPLETE);
+    CHECK(replay.step().status == STEP_COMPLETE);
+    for (unsigned int id = 0; id < live.num_cells; id++) {
+      for (auto& n : live.getNeighborsMatching(id, CONNECTED)) {
+        CHECK(replayed.queryConnection(id, n) == CONNECTED);
+      }
+      CHECK(replayed.getNeighborsMatching(id, CONNECTED).size() ==
+            live.getNeighborsMatching(id, CONNECTED).size());
+      CHECK(replayed.getCell(id).visited == live.getCell(id).visited);
+    }
+  }
+
+  SUBCASE("A log only replays onto a grid of the size it was recorded on") {
+    std::cout << "  (A log only replays onto a grid of the size it was "
+                 "recorded on)\n";
+    Grid<Cell> other(16, 32);
+    CHECK_THROWS_AS(ReplayStrategy<>(&other, log), const char*);
+  }
+
+  SUBCASE("Recording resets the grid it records on") {
+    std::cout << "  (Recording resets the grid it records on)\n";
+    std::stringstream first_maze;
+    recorded.saveState(first_maze);
+    // leave a passage and an emphasized cell that the first maze does not
+    // have, as though another maze had been half drawn on the grid.
+    unsigned int dirty = 0;
+    while (recorded.queryConnection(dirty, dirty + 1) == CONNECTED) {
+      dirty++;
+    }
+    recorded.modifyConnection(dirty, dirty + 1, CONNECTED);
+    Cell emphasized = recorded.getCell(dirty);
+    emphasized.emphasized = true;
+    recorded.setCell(dirty, emphasized);
+
+    Log again = Log::record<HuntAndKillStrategy>(&recorded, Rng(5));
+    CHECK(recorded.queryConnection(dirty, dirty + 1) == CONNECTABLE);
+    CHECK(!recorded.getCell(dirty).emphasized);
+    CHECK(isPerfectMaze(recorded));
+    std::stringstream second_maze;
+    recorded.saveState(second_maze);
+    CHECK(second_maze.str() == first_maze.str());
+
+    // both logs replay the same steps, to the same maze.
+    REQUIRE(again.numSteps() == log->numSteps());
+    Grid<Cell> from_first(32, 32);
+    Grid<Cell> from_again(32, 32);
+    for (unsigned int i = 0; i < again.numSteps(); i++) {
+      StepResult expected = log->replayStep(i, &from_first);
+      StepResult got = again.replayStep(i, &from_again);
+      CHECK(got.status == expected.status);
+      CHECK(got.delay == expected.delay);
+    }
+    std::stringstream replayed_first;
+    std::stringstream replayed_again;
+    from_first.saveState(replayed_first);
+    from_again.saveState(replayed_again);
+    CHECK(replayed_again.str() == replayed_first.str());
+    CHECK(replayed_first.str() == first_maze.str());
+  }
+}
+
+TEST_CASE("A maze can replay a generation log and start over in place.") {
+  std::cout << "(A maze can replay a generation log and start over in "
+               "place)\n";
+  Grid<Cell> scratch(32, 32);
+  auto first = std::make_shared<const Log>(
+      Log::record<RecursiveBacktrackerStrategy>(&scratch, Rng(1)));
+  auto second = std::make_shared<const Log>(
+      Log::record<RecursiveBacktrackerStrategy>(&scratch, Rng(2)));
+
+  FrameCanvas* c = new FrameCanvas;
+  ReplayMaze m(c, first);
+  m.generateAll();
+
+  SUBCASE("A replayed maze draws what the strategy would have") {
+    std::cout << "  (A replayed maze draws what the strategy would have)\n";
+    FrameCanvas* c2 = new FrameCanvas;
+    Maze<RecursiveBacktrackerStrategy<>, Cell, FrameCanvas> live(c2, Rng(1));
+    live.generateAll();
+    CHECK(c->frame == c2->frame);
+    CHECK(m.generatePixelMap() == live.generatePixelMap());
+    delete c2;
+  }
+
+  SUBCASE("Starting over draws only what differs from a fresh maze") {
+    std::cout << "  (Starting over draws only what differs from a fresh "
+                 "maze)\n";
+    c->draws = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    m.reset(second);
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "    started over in " << duration.count()
+              << " microseconds.\n";
+    CHECK(!m.generated);
+    CHECK(c->draws > 0);
+    CHECK(c->draws < 64 * 64);
+
+    // the reset maze ends up just like a maze built fresh for the log.
+    m.generateAll();
+    FrameCanvas* c2 = new FrameCanvas;
+    ReplayMaze fresh(c2, second);
+    fresh.generateAll();
+    CHECK(c->frame == c2->frame);
+    CHECK(m.generatePixelMap() == fresh.generatePixelMap());
+    delete c2;
+  }
+  delete c;
+}
+
+TEST_CASE("A bounded queue blocks its producer once full.") {
+  std::cout << "(A bounded queue blocks its producer once full)\n";
+  BoundedQueue<int> queue(2);
+  CHECK(queue.push(1));
+  CHECK(queue.push(2));
+  CHECK(queue.size() == 2);
+
+  SUBCASE("A full queue makes room as items are taken") {
+    std::cout << "  (A full queue makes room as items are taken)\n";
+    std::thread producer([&queue] { queue.push(3); });
+    int item = 0;
+    CHECK(queue.pop(item));
+    CHECK(item == 1);
+    producer.join();
+    CHECK(queue.pop(item));
+    CHECK(item == 2);
+    CHECK(queue.pop(item));
+    CHECK(item == 3);
+  }
+
+  SUBCASE("Closing wakes a waiting producer and drains the rest") {
+    std::cout << "  (Closing wakes a waiting producer and drains the "
+                 "rest)\n";
+    bool pushed = true;
+    std::thread producer([&queue, &pushed] { pushed = queue.push(3); });
+    queue.close();
+    producer.join();
+    CHECK(!pushed);
+    int item = 0;
+    CHECK(queue.pop(item));
+    CHECK(queue.pop(item));
+    CHECK(!queue.pop(item));
+  }
+}
+
+TEST_CASE("A maze producer generates mazes ahead of time.") {
+  std::cout << "(A maze producer generates mazes ahead of time)\n";
+
+  SUBCASE("The same seed gives the same mazes") {
+    std::cout << "  (The same seed gives the same mazes)\n";
+    MazeProducer<HuntAndKillStrategy> a(32, 32, Rng(7));
+    MazeProducer<HuntAndKillStrategy> b(32, 32, Rng(7));
+    for (int i = 0; i < 3; i++) {
+      auto log_a = a.next();
+      auto log_b = b.next();
+      REQUIRE(log_a != nullptr);
+      REQUIRE(log_b != nullptr);
+      CHECK(log_a->numSteps() == log_b->numSteps());
+      FrameCanvas* ca = new FrameCanvas;
+      FrameCanvas* cb = new FrameCanvas;
+      ReplayMaze ma(ca, log_a);
+      ReplayMaze mb(cb, log_b);
+      ma.generateAll();
+      mb.generateAll();
+      CHECK(ca->frame == cb->frame);
+      delete ca;
+      delete cb;
+    }
+  }
+
+  SUBCASE("The next maze is ready while the current one is shown") {
+    std::cout << "  (The next maze is ready while the current one is "
+                 "shown)\n";
+    MazeProducer<HuntAndKillStrategy> producer(32, 32, Rng(8));
+    FrameCanvas* c = new FrameCanvas;
+    ReplayMaze m(c, producer.next());
+    // stand in for the time a finished maze sits on display.
+    while (producer.ready() == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    auto next = producer.next();
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "    handed over the next maze in " << duration.count()
+              << " microseconds.\n";
+    REQUIRE(next != nullptr);
+    m.reset(next);
+    m.generateAll();
+    CHECK(m.generated);
+    delete c;
+  }
+
+  SUBCASE("A stopped producer hands out no more mazes") {
+    std::cout << "  (A stopped producer hands out no more mazes)\n";
+    MazeProducer<HuntAndKillStrategy> producer(32, 32, Rng(9));
+    producer.stop();
+    while (producer.next() != nullptr) {
+    }
+    CHECK(producer.next() == nullptr);
+  }
+}
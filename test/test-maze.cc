@@ -1,23 +1,76 @@
 #include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 
 #include "cell.h"
 #include "doctest.h"
+#include "hunt-and-kill.h"
 #include "maze.h"
+#include "recursive-backtracker.h"
 
 struct TestStrategy {
   Grid<Cell>* g;
   TestStrategy(Grid<Cell>* grid) : g(grid){};
-  float step() {
+  StepResult step() {
     g->modifyConnection(0, 1, CONNECTED);
     Cell c;
     c.visited = true;
     c.emphasized = true;
     g->setCell(2, c);
-    return 0.1;
+    return StepResult{STEP_CONTINUE, 0.1};
   };
 };
 
+struct DiagonalTestStrategy {
+  Grid<Cell, DynamicDimensions, DiagonalTopology>* g;
+  DiagonalTestStrategy(Grid<Cell, DynamicDimensions, DiagonalTopology>* grid)
+      : g(grid){};
+  StepResult step() {
+    // cell 33 is up and to the left of cell 2 in a 32 column grid.
+    g->modifyConnection(0, 33, CONNECTED);
+    g->modifyConnection(2, 33, CONNECTED);
+    return StepResult{STEP_CONTINUE, 0.1};
+  };
+};
+
+// LineStrategy carves a passage along row 0 each step, and counts its
+// steps where a StepCanvas can see them.
+struct LineStrategy {
+  Grid<Cell>* g;
+  unsigned int* steps;
+  LineStrategy(Grid<Cell>* grid, unsigned int* steps)
+      : g(grid), steps(steps){};
+  StepResult step() {
+    (*steps)++;
+    g->modifyConnection(*steps - 1, *steps, CONNECTED);
+    return StepResult{STEP_CONTINUE, 0.1};
+  };
+};
+
+// StepCanvas records how many steps had been taken when each pixel was
+// drawn.
+struct StepCanvas {
+  unsigned int* steps;
+  std::vector<std::tuple<int, int, unsigned int> > draws;
+  StepCanvas(unsigned int* steps) : steps(steps){};
+  int width() { return 64; };
+  int height() { return 64; };
+  void SetPixel(int x, int y, int r, int g, int b) {
+    this->draws.push_back(std::tuple<int, int, unsigned int>(x, y, *steps));
+  };
+  std::vector<unsigned int> getStepsDrawnAt(int tx, int ty) {
+    std::vector<unsigned int> matching;
+    for (const auto& draw : this->draws) {
+      auto const [x, y, step] = draw;
+      if (x == tx && y == ty) {
+        matching.push_back(step);
+      }
+    }
+    return matching;
+  }
+};
+
 struct TestCanvas {
   int w = 64;
   int h = 64;
@@ -45,6 +98,31 @@ struct TestCanvas {
   }
 };
 
+TEST_CASE("A frame buffer packs pixels row after row.") {
+  std::cout << "(A frame buffer packs pixels row after row)\n";
+  using Pixel = FrameBuffer::Pixel;
+  FrameBuffer frame(3, 4, Pixel(1, 2, 3));
+  CHECK(frame.size() == 3);
+  CHECK(frame[0].size() == 4);
+  CHECK(frame.footprint() == 3 * 4 * 3);
+  frame.set(1, 2, Pixel(255, 0, 7));
+  CHECK(frame[1][2] == Pixel(255, 0, 7));
+  CHECK(frame.get(1, 1) == Pixel(1, 2, 3));
+  // pixel (1, 2) is the seventh of the frame.
+  CHECK(frame.data()[6 * 3] == 255);
+  CHECK(frame.data()[6 * 3 + 2] == 7);
+  unsigned int rows = 0;
+  for (auto const& row : frame) {
+    CHECK(row.size() == 4);
+    rows++;
+  }
+  CHECK(rows == 3);
+  FrameBuffer other(3, 4, Pixel(1, 2, 3));
+  CHECK(frame != other);
+  other.set(1, 2, Pixel(255, 0, 7));
+  CHECK(frame == other);
+}
+
 TEST_CASE("A maze can be created.") {
   std::cout << "(A maze can be created)\n";
   auto start = std::chrono::high_resolution_clock::now();
@@ -134,19 +212,19 @@ TEST_CASE("A maze can be created.") {
       CHECK(std::get<2>(p[0]) == 0);
       CHECK(std::get<3>(p[0]) == 255);
       CHECK(std::get<4>(p[0]) == 0);
-      p = c->getCallsForSpecificPixel(0, 1);
+      p = c->getCallsForSpecificPixel(1, 0);
       CHECK(p.size() == 1);
       CHECK(std::get<2>(p[0]) == 0);
       CHECK(std::get<3>(p[0]) == 255);
       CHECK(std::get<4>(p[0]) == 0);
-      p = c->getCallsForSpecificPixel(0, 2);
+      p = c->getCallsForSpecificPixel(2, 0);
       CHECK(p.size() == 1);
       CHECK(std::get<2>(p[0]) == 0);
       CHECK(std::get<3>(p[0]) == 255);
       CHECK(std::get<4>(p[0]) == 0);
-      p = c->getCallsForSpecificPixel(0, 3);
+      p = c->getCallsForSpecificPixel(3, 0);
       CHECK(p.size() == 0);
-      p = c->getCallsForSpecificPixel(0, 4);
+      p = c->getCallsForSpecificPixel(4, 0);
       CHECK(p.size() == 1);
       CHECK(std::get<2>(p[0]) == 255);
       CHECK(std::get<3>(p[0]) == 0);
@@ -155,3 +233,270 @@ TEST_CASE("A maze can be created.") {
   }
   delete c;
 }
+
+TEST_CASE("A maze can be drawn with diagonal passages.") {
+  std::cout << "(A maze can be drawn with diagonal passages)\n";
+  TestCanvas* c = new TestCanvas;
+  Maze<DiagonalTestStrategy, Cell, TestCanvas, DynamicDimensions,
+       DiagonalTopology>
+      m(c);
+  m.generateStep();
+  auto map = m.generatePixelMap();
+  using Pixel = Maze<TestStrategy, Cell>::Pixel;
+  CHECK(map[0][0] == Pixel({0, 255, 0}));
+  CHECK(map[1][1] == Pixel({0, 255, 0}));
+  CHECK(map[2][2] == Pixel({0, 255, 0}));
+  CHECK(map[1][3] == Pixel({0, 255, 0}));
+  CHECK(map[0][4] == Pixel({0, 255, 0}));
+  CHECK(map[0][2] == Pixel({255, 255, 255}));
+  CHECK(map[1][2] == Pixel({0, 0, 0}));
+  delete c;
+}
+
+TEST_CASE("A maze can be checkpointed and resumed.") {
+  std::cout << "(A maze can be checkpointed and resumed)\n";
+  const std::string path = "test-maze-checkpoint.bin";
+  TestCanvas* c = new TestCanvas;
+  Maze<HuntAndKillStrategy<>, Cell, TestCanvas> m(c);
+  for (int i = 0; i < 200; i++) {
+    m.generateStep();
+  }
+  m.updatePixelMap();
+  m.saveCheckpoint(path);
+
+  SUBCASE("The resumed maze matches the checkpointed one") {
+    std::cout << "  (The resumed maze matches the checkpointed one)\n";
+    TestCanvas* c2 = new TestCanvas;
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> resumed(c2);
+    c2->clearPixelCalls();
+    auto start = std::chrono::high_resolution_clock::now();
+    resumed.loadCheckpoint(path);
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "    resumed a 32x32 maze in " << duration.count()
+              << " microseconds.\n";
+    CHECK(resumed.generatePixelMap() == m.generatePixelMap());
+    // the whole canvas is redrawn once.
+    CHECK(c2->getPixelCalls().size() == 64 * 64);
+    CHECK(resumed.generated == m.generated);
+    delete c2;
+  }
+
+  SUBCASE("The resumed maze can finish generating") {
+    std::cout << "  (The resumed maze can finish generating)\n";
+    TestCanvas* c2 = new TestCanvas;
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> resumed(c2);
+    resumed.loadCheckpoint(path);
+    while (!resumed.generated) {
+      resumed.generateStep();
+    }
+    resumed.updatePixelMap();
+    auto map = resumed.generatePixelMap();
+    for (unsigned int i = 0; i < map.size(); i += 2) {
+      for (unsigned int j = 0; j < map[i].size(); j += 2) {
+        CHECK(map[i][j] != std::make_tuple(255u, 255u, 255u));
+      }
+    }
+    delete c2;
+  }
+
+  SUBCASE("A resumed seeded maze comes out as it would have") {
+    std::cout << "  (A resumed seeded maze comes out as it would have)\n";
+    TestCanvas* c2 = new TestCanvas;
+    TestCanvas* c3 = new TestCanvas;
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> uninterrupted(c2, Rng(9));
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> stopped(c3, Rng(9));
+    for (int i = 0; i < 300; i++) {
+      uninterrupted.generateStep();
+      stopped.generateStep();
+    }
+    stopped.saveCheckpoint(path);
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> resumed(c3, Rng(10));
+    resumed.loadCheckpoint(path);
+    while (!uninterrupted.generated) {
+      uninterrupted.generateStep();
+    }
+    while (!resumed.generated) {
+      resumed.generateStep();
+    }
+    CHECK(resumed.generatePixelMap() == uninterrupted.generatePixelMap());
+    delete c2;
+    delete c3;
+  }
+
+  SUBCASE("A checkpoint of a different size is refused") {
+    std::cout << "  (A checkpoint of a different size is refused)\n";
+    TestCanvas* c2 = new TestCanvas;
+    c2->w = 32;
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> other(c2);
+    CHECK_THROWS_AS(other.loadCheckpoint(path), CheckpointException);
+    delete c2;
+  }
+
+  SUBCASE("A truncated checkpoint is refused") {
+    std::cout << "  (A truncated checkpoint is refused)\n";
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out << "LMZ";
+    }
+    TestCanvas* c2 = new TestCanvas;
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> other(c2);
+    CHECK_THROWS_AS(other.loadCheckpoint(path), CheckpointException);
+    delete c2;
+  }
+
+  std::remove(path.c_str());
+  delete c;
+}
+
+TEST_CASE("A maze can report its memory footprint.") {
+  std::cout << "(A maze can report its memory footprint)\n";
+  TestCanvas* c = new TestCanvas;
+  Maze<HuntAndKillStrategy<>, Cell, TestCanvas> m(c);
+  auto before = m.footprint();
+  CHECK(before.pixel_map == 64 * 64 * FrameBuffer::bytes_per_pixel);
+  CHECK(before.total() > before.grid.total());
+
+  SUBCASE("The peak footprint holds the most used during generation") {
+    std::cout
+        << "  (The peak footprint holds the most used during generation)\n";
+    while (!m.generated) {
+      m.generateStep();
+      m.updatePixelMap();
+    }
+    auto peak = m.peakFootprint();
+    auto after = m.footprint();
+    CHECK(peak.pixels_to_update > 0);
+    CHECK(peak.modified_buffers > 0);
+    CHECK(peak.total() >= after.total());
+    CHECK(peak.total() >= before.total());
+    std::cout << "    peak footprint of a 32x32 maze:\n" << peak;
+  }
+  delete c;
+}
+
+TEST_CASE("A maze reports when its generation is complete.") {
+  std::cout << "(A maze reports when its generation is complete)\n";
+  TestCanvas* c = new TestCanvas;
+  Maze<HuntAndKillStrategy<>, Cell, TestCanvas> m(c);
+  unsigned int steps = 0;
+  StepResult result = m.advance();
+  while (result.status == STEP_CONTINUE) {
+    steps++;
+    result = m.advance();
+  }
+  CHECK(m.generated);
+  // every step but the last joins one cell to the maze.
+  CHECK(steps == 32 * 32 - 1);
+  // stepping a generated maze is a mistake.
+  CHECK_THROWS_AS(m.advance(), GenerationCompleteException);
+  delete c;
+}
+
+TEST_CASE("A maze can be generated by recursive backtracking.") {
+  std::cout << "(A maze can be generated by recursive backtracking)\n";
+  TestCanvas* c = new TestCanvas;
+  Maze<RecursiveBacktrackerStrategy<>, Cell, TestCanvas> m(c, Rng(1));
+  while (!m.generated) {
+    m.generateStep();
+    m.updatePixelMap();
+  }
+  auto map = m.generatePixelMap();
+  for (unsigned int i = 0; i < map.size(); i += 2) {
+    for (unsigned int j = 0; j < map[i].size(); j += 2) {
+      CHECK(map[i][j] == std::make_tuple(0u, 255u, 0u));
+    }
+  }
+  delete c;
+}
+
+TEST_CASE("A maze can be generated in parallel regions.") {
+  std::cout << "(A maze can be generated in parallel regions)\n";
+  TestCanvas* c = new TestCanvas;
+  Maze<HuntAndKillStrategy<>, Cell, TestCanvas> m(c);
+  c->clearPixelCalls();
+  m.generateParallel<HuntAndKillStrategy>(4, Rng(2));
+  CHECK(m.generated);
+  // the whole maze is drawn at once.
+  auto map = m.generatePixelMap();
+  for (unsigned int i = 0; i < map.size(); i += 2) {
+    for (unsigned int j = 0; j < map[i].size(); j += 2) {
+      CHECK(map[i][j] != std::make_tuple(255u, 255u, 255u));
+    }
+  }
+  CHECK(c->getPixelCalls().size() > 0);
+  CHECK_THROWS_AS(m.generateParallel<HuntAndKillStrategy>(4, Rng(2)),
+                  GenerationCompleteException);
+  delete c;
+}
+
+TEST_CASE("A maze can take many steps before drawing.") {
+  std::cout << "(A maze can take many steps before drawing)\n";
+  TestCanvas* c = new TestCanvas;
+  Maze<HuntAndKillStrategy<>, Cell, TestCanvas> m(c, Rng(12));
+  c->clearPixelCalls();
+
+  SUBCASE("A batch of steps is drawn once at the end") {
+    std::cout << "  (A batch of steps is drawn once at the end)\n";
+    CHECK(m.generateSteps(100) == 100);
+    auto calls = c->getPixelCalls();
+    // every pixel drawn is drawn once, no matter how often it changed.
+    std::sort(calls.begin(), calls.end());
+    for (unsigned int i = 1; i < calls.size(); i++) {
+      CHECK((std::get<0>(calls[i]) != std::get<0>(calls[i - 1]) ||
+             std::get<1>(calls[i]) != std::get<1>(calls[i - 1])));
+    }
+    CHECK(!m.generated);
+  }
+
+  SUBCASE("Generating everything matches stepping one at a time") {
+    std::cout << "  (Generating everything matches stepping one at a time)\n";
+    TestCanvas* c2 = new TestCanvas;
+    Maze<HuntAndKillStrategy<>, Cell, TestCanvas> stepped(c2, Rng(12));
+    auto start = std::chrono::high_resolution_clock::now();
+    while (!stepped.generated) {
+      stepped.generateStep();
+      stepped.updatePixelMap();
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto stepped_time =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    start = std::chrono::high_resolution_clock::now();
+    const unsigned int steps = m.generateAll();
+    stop = std::chrono::high_resolution_clock::now();
+    auto all_time =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "    stepped and drawn in " << stepped_time.count()
+              << " microseconds, generated then drawn in " << all_time.count()
+              << " microseconds.\n";
+    CHECK(m.generated);
+    CHECK(steps == 32 * 32);
+    CHECK(m.generatePixelMap() == stepped.generatePixelMap());
+    CHECK(c->getPixelCalls().size() < c2->getPixelCalls().size());
+    CHECK_THROWS_AS(m.generateAll(), GenerationCompleteException);
+    delete c2;
+  }
+
+  SUBCASE("Progress can be drawn every few steps") {
+    std::cout << "  (Progress can be drawn every few steps)\n";
+    unsigned int steps = 0;
+    StepCanvas* sc = new StepCanvas(&steps);
+    Maze<LineStrategy, Cell, StepCanvas> line(sc, &steps);
+    sc->draws.clear();
+    CHECK(line.generateSteps(10, 5) == 10);
+    // step 1 opens the passage at pixel column 1, step 7 the one at 13.
+    CHECK(sc->getStepsDrawnAt(1, 0) == std::vector<unsigned int>({5}));
+    CHECK(sc->getStepsDrawnAt(13, 0) == std::vector<unsigned int>({10}));
+
+    unsigned int other_steps = 0;
+    StepCanvas* sc2 = new StepCanvas(&other_steps);
+    Maze<LineStrategy, Cell, StepCanvas> unrendered(sc2, &other_steps);
+    sc2->draws.clear();
+    CHECK(unrendered.generateSteps(10) == 10);
+    CHECK(sc2->getStepsDrawnAt(1, 0) == std::vector<unsigned int>({10}));
+    delete sc;
+    delete sc2;
+  }
+  delete c;
+}
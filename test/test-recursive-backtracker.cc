@@ -0,0 +1,65 @@
+#include <chrono>
+#include <iostream>
+
+#include "cell.h"
+#include "doctest.h"
+#include "maze-checks.h"
+#include "recursive-backtracker.h"
+
+TEST_CASE("The recursive backtracker strategy can be created.") {
+  Grid<Cell> g(32, 32);
+  RecursiveBacktrackerStrategy<Cell> strat(&g, Rng(3));
+
+  SUBCASE("The starting cell is visited and on the stack") {
+    CHECK(strat.current_cell < 32 * 32);
+    CHECK(g.getCell(strat.current_cell).visited);
+    CHECK(strat.stack.size() == 1);
+    CHECK(strat.stack.capacity() >= g.num_cells);
+  }
+
+  SUBCASE("Each step carves to a new cell or backs up one cell") {
+    for (int i = 0; i < 500; i++) {
+      const unsigned int depth = strat.stack.size();
+      const unsigned int visited = g.getCells().countVisited();
+      if (strat.step().status == STEP_COMPLETE) {
+        break;
+      }
+      if (strat.stack.size() > depth) {
+        CHECK(strat.stack.size() == depth + 1);
+        CHECK(g.getCells().countVisited() == visited + 1);
+        CHECK(g.queryConnection(strat.stack[depth - 1], strat.stack[depth]) ==
+              CONNECTED);
+      } else {
+        CHECK(strat.stack.size() == depth - 1);
+        CHECK(g.getCells().countVisited() == visited);
+      }
+    }
+  }
+
+  SUBCASE("Stepping until complete visits every cell without allocating") {
+    const auto* stack_data = strat.stack.data();
+    auto start = std::chrono::high_resolution_clock::now();
+    while (strat.step().status != STEP_COMPLETE) {
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "  generated a 32x32 maze by backtracking in "
+              << duration.count() << " microseconds.\n";
+    CHECK(g.getCells().countVisited() == g.num_cells);
+    CHECK(isPerfectMaze(g));
+    CHECK(strat.stack.empty());
+    CHECK(strat.stack.data() == stack_data);
+    CHECK(strat.step().status == STEP_COMPLETE);
+  }
+}
+
+TEST_CASE("The recursive backtracker strategy works with other topologies.") {
+  Grid<Cell, DynamicDimensions, HexTopology> g(16, 16);
+  RecursiveBacktrackerStrategy<Cell, DynamicDimensions, HexTopology> strat(
+      &g);
+  while (strat.step().status != STEP_COMPLETE) {
+  }
+  CHECK(g.getCells().countVisited() == g.num_cells);
+  CHECK(isPerfectMaze(g));
+}
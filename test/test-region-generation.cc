@@ -0,0 +1,51 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "cell.h"
+#include "doctest.h"
+#include "hunt-and-kill.h"
+#include "kruskal.h"
+#include "maze-checks.h"
+#include "region-generation.h"
+
+TEST_CASE("A grid can be generated in regions on several threads.") {
+  std::cout << "(A grid can be generated in regions on several threads)\n";
+
+  SUBCASE("Regions are joined into one perfect maze") {
+    std::cout << "  (Regions are joined into one perfect maze)\n";
+    for (unsigned int regions : {1, 2, 3, 4}) {
+      Grid<Cell> g(256, 256);
+      auto start = std::chrono::high_resolution_clock::now();
+      CHECK(generateInRegions<HuntAndKillStrategy>(&g, regions, Rng(6)) ==
+            regions);
+      auto stop = std::chrono::high_resolution_clock::now();
+      auto duration =
+          std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+      std::cout << "    generated a 256x256 maze in " << regions
+                << " regions in " << duration.count() << " microseconds.\n";
+      CHECK(isPerfectMaze(g));
+      CHECK(g.getCells().countVisited() == g.num_cells);
+    }
+  }
+
+  SUBCASE("Hex regions line up with the rows they cover") {
+    std::cout << "  (Hex regions line up with the rows they cover)\n";
+    Grid<Cell, DynamicDimensions, HexTopology> g(15, 16);
+    // 7 pairs of rows and one row left over, for at most 7 regions.
+    CHECK(generateInRegions<KruskalStrategy>(&g, 10, Rng(6)) == 7);
+    CHECK(isPerfectMaze(g));
+  }
+
+  SUBCASE("The same seed gives the same maze") {
+    std::cout << "  (The same seed gives the same maze)\n";
+    Grid<Cell> a(32, 32);
+    Grid<Cell> b(32, 32);
+    generateInRegions<HuntAndKillStrategy>(&a, 4, Rng(1));
+    generateInRegions<HuntAndKillStrategy>(&b, 4, Rng(1));
+    for (unsigned int id = 0; id < a.num_cells; id++) {
+      CHECK(a.getCellIdsMatching(id, CONNECTED) ==
+            b.getCellIdsMatching(id, CONNECTED));
+    }
+  }
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "doctest.h"
+#include "rng.h"
+
+TEST_CASE("A random number generator can be created.") {
+  std::cout << "(A random number generator can be created)\n";
+  Rng rng(42);
+
+  SUBCASE("The same seed gives the same stream") {
+    std::cout << "  (The same seed gives the same stream)\n";
+    Rng same(42);
+    Rng other(43);
+    bool differs = false;
+    for (int i = 0; i < 100; i++) {
+      uint32_t value = rng.next();
+      CHECK(value == same.next());
+      differs = differs || value != other.next();
+    }
+    CHECK(differs);
+  }
+
+  SUBCASE("Bounded draws are in range and evenly spread") {
+    std::cout << "  (Bounded draws are in range and evenly spread)\n";
+    std::vector<unsigned int> counts(6, 0);
+    const unsigned int draws = 60000;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned int i = 0; i < draws; i++) {
+      uint32_t value = rng.below(6);
+      REQUIRE(value < 6);
+      counts[value]++;
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "    " << draws << " bounded draws in " << duration.count()
+              << " microseconds.\n";
+    for (auto count : counts) {
+      CHECK(count > draws / 6 - 500);
+      CHECK(count < draws / 6 + 500);
+    }
+    CHECK(rng.below(1) == 0);
+  }
+
+  SUBCASE("Split streams are independent and reproducible") {
+    std::cout << "  (Split streams are independent and reproducible)\n";
+    Rng again(42);
+    Rng a = rng.split();
+    Rng b = rng.split();
+    Rng a_again = again.split();
+    Rng b_again = again.split();
+    bool differs = false;
+    for (int i = 0; i < 100; i++) {
+      uint32_t from_a = a.next();
+      uint32_t from_b = b.next();
+      CHECK(from_a == a_again.next());
+      CHECK(from_b == b_again.next());
+      differs = differs || from_a != from_b;
+    }
+    CHECK(differs);
+  }
+
+  SUBCASE("The state can be saved and restored") {
+    std::cout << "  (The state can be saved and restored)\n";
+    rng.next();
+    std::stringstream state;
+    rng.saveState(state);
+    Rng restored(7);
+    restored.loadState(state);
+    for (int i = 0; i < 100; i++) {
+      CHECK(rng.next() == restored.next());
+    }
+  }
+}
@@ -0,0 +1,173 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include "cell.h"
+#include "disjoint-sets.h"
+#include "doctest.h"
+#include "maze-checks.h"
+#include "row-bitboards.h"
+#include "row-carving.h"
+
+// a maze is perfect when its passages join every cell without a cycle.
+static bool isPerfect(const RowBitboards& rows) {
+  const unsigned int cols = rows.numCols();
+  DisjointSets sets(rows.numRows() * cols);
+  unsigned int joined = 0;
+  for (unsigned int row = 0; row < rows.numRows(); row++) {
+    for (unsigned int col = 0; col < cols; col++) {
+      const unsigned int id = row * cols + col;
+      if (rows.hasEast(row, col)) {
+        if (col + 1 >= cols || !sets.unite(id, id + 1)) {
+          return false;
+        }
+        joined++;
+      }
+      if (rows.hasUp(row, col)) {
+        if (row + 1 >= rows.numRows() || !sets.unite(id, id + cols)) {
+          return false;
+        }
+        joined++;
+      }
+    }
+  }
+  return joined == rows.numRows() * cols - 1;
+}
+
+// run a strategy on g until it is complete.
+template <class Strategy>
+static void generateGrid(Grid<Cell>& g) {
+  Strategy strat(&g, Rng(4));
+  while (strat.step().status != STEP_COMPLETE) {
+  }
+  CHECK(g.getCells().countVisited() == g.num_cells);
+}
+
+TEST_CASE("Row bitboards carve perfect mazes a word at a time.") {
+  std::cout << "(Row bitboards carve perfect mazes a word at a time)\n";
+
+  SUBCASE("Binary tree mazes are perfect, at any width") {
+    std::cout << "  (Binary tree mazes are perfect, at any width)\n";
+    for (unsigned int cols : {1u, 5u, 63u, 64u, 65u, 200u}) {
+      RowBitboards rows(9, cols);
+      Rng rng(cols);
+      rows.carveBinaryTree(rng);
+      CHECK(rows.wordsPerRow() == (cols + 63) / 64);
+      CHECK(rows.countPassages() == 9 * cols - 1);
+      CHECK(isPerfect(rows));
+      // the top row is a single corridor east.
+      for (unsigned int col = 0; col + 1 < cols; col++) {
+        CHECK(rows.hasEast(8, col));
+      }
+      CHECK(!rows.hasEast(3, cols - 1));
+    }
+  }
+
+  SUBCASE("Sidewinder mazes are perfect, at any width") {
+    std::cout << "  (Sidewinder mazes are perfect, at any width)\n";
+    for (unsigned int cols : {1u, 5u, 63u, 64u, 65u, 200u}) {
+      RowBitboards rows(9, cols);
+      Rng rng(cols);
+      rows.carveSidewinder(rng);
+      CHECK(rows.countPassages() == 9 * cols - 1);
+      CHECK(isPerfect(rows));
+    }
+  }
+
+  SUBCASE("A large maze is carved headless") {
+    std::cout << "  (A large maze is carved headless)\n";
+    RowBitboards rows(1024, 1024);
+    Rng rng(1);
+    auto start = std::chrono::high_resolution_clock::now();
+    rows.carveBinaryTree(rng);
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto tree_time =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    start = std::chrono::high_resolution_clock::now();
+    rows.carveSidewinder(rng);
+    stop = std::chrono::high_resolution_clock::now();
+    auto sidewinder_time =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "    carved 1024x1024 by binary tree in " << tree_time.count()
+              << " microseconds, by sidewinder in " << sidewinder_time.count()
+              << " microseconds, " << rows.footprint() << " bytes.\n";
+    CHECK(rows.countPassages() == 1024 * 1024 - 1);
+    CHECK(isPerfect(rows));
+  }
+
+  SUBCASE("The same seed carves the same maze") {
+    std::cout << "  (The same seed carves the same maze)\n";
+    RowBitboards a(16, 100);
+    RowBitboards b(16, 100);
+    Rng rng_a(6);
+    Rng rng_b(6);
+    a.carveSidewinder(rng_a);
+    b.carveSidewinder(rng_b);
+    for (unsigned int row = 0; row < 16; row++) {
+      for (unsigned int w = 0; w < a.wordsPerRow(); w++) {
+        CHECK(a.eastRow(row)[w] == b.eastRow(row)[w]);
+        CHECK(a.upRow(row)[w] == b.upRow(row)[w]);
+      }
+    }
+  }
+}
+
+TEST_CASE("Bitboard strategies fill a grid a row per step.") {
+  std::cout << "(Bitboard strategies fill a grid a row per step)\n";
+  Grid<Cell> g(32, 32);
+
+  SUBCASE("The binary tree strategy makes a perfect maze") {
+    std::cout << "  (The binary tree strategy makes a perfect maze)\n";
+    generateGrid<BinaryTreeStrategy<>>(g);
+    CHECK(isPerfectMaze(g));
+  }
+
+  SUBCASE("The sidewinder strategy makes a perfect maze") {
+    std::cout << "  (The sidewinder strategy makes a perfect maze)\n";
+    generateGrid<SidewinderStrategy<>>(g);
+    CHECK(isPerfectMaze(g));
+  }
+
+  SUBCASE("Each step opens exactly the row it carved") {
+    std::cout << "  (Each step opens exactly the row it carved)\n";
+    SidewinderStrategy<> strat(&g, Rng(2));
+    for (unsigned int row = 0; row < 32; row++) {
+      CHECK(strat.step().status == STEP_CONTINUE);
+      for (unsigned int col = 0; col < 32; col++) {
+        const unsigned int id = row * 32 + col;
+        if (col + 1 < 32) {
+          CHECK((g.queryConnection(id, id + 1) == CONNECTED) ==
+                strat.rows.hasEast(row, col));
+        }
+        if (row + 1 < 32) {
+          CHECK((g.queryConnection(id, id + 32) == CONNECTED) ==
+                strat.rows.hasUp(row, col));
+        }
+      }
+    }
+    CHECK(strat.step().status == STEP_COMPLETE);
+  }
+
+  SUBCASE("A checkpoint resumes from the next row") {
+    std::cout << "  (A checkpoint resumes from the next row)\n";
+    Grid<Cell> other(32, 32);
+    BinaryTreeStrategy<> a(&g, Rng(3));
+    BinaryTreeStrategy<> b(&other, Rng(3));
+    for (int i = 0; i < 10; i++) {
+      a.step();
+    }
+    std::stringstream checkpoint;
+    a.saveState(checkpoint);
+    for (int i = 0; i < 10; i++) {
+      b.step();
+    }
+    b.loadState(checkpoint);
+    while (a.step().status != STEP_COMPLETE) {
+      b.step();
+    }
+    for (unsigned int id = 0; id < g.num_cells; id++) {
+      CHECK(g.getNeighborsMatching(id, CONNECTED).size() ==
+            other.getNeighborsMatching(id, CONNECTED).size());
+    }
+  }
+}
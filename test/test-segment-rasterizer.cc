@@ -0,0 +1,67 @@
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "doctest.h"
+#include "segment-rasterizer.h"
+
+using Point = std::tuple<int, int>;
+
+static std::vector<Point> rasterize(int x1, int y1, int x2, int y2) {
+  std::vector<Point> points;
+  rasterizeSegment(x1, y1, x2, y2,
+                   [&points](int x, int y) { points.push_back(Point(x, y)); });
+  return points;
+}
+
+TEST_CASE("Segments are rasterized without gaps.") {
+  std::cout << "(Segments are rasterized without gaps)\n";
+
+  SUBCASE("Horizontal and vertical passages, in either direction") {
+    std::cout << "  (Horizontal and vertical passages, in either "
+                 "direction)\n";
+    CHECK(rasterize(0, 2, 2, 2) ==
+          std::vector<Point>({Point(0, 2), Point(1, 2), Point(2, 2)}));
+    CHECK(rasterize(2, 2, 0, 2) ==
+          std::vector<Point>({Point(2, 2), Point(1, 2), Point(0, 2)}));
+    CHECK(rasterize(4, 0, 4, 2) ==
+          std::vector<Point>({Point(4, 0), Point(4, 1), Point(4, 2)}));
+    CHECK(rasterize(4, 2, 4, 0) ==
+          std::vector<Point>({Point(4, 2), Point(4, 1), Point(4, 0)}));
+  }
+
+  SUBCASE("Diagonal passages, in every direction") {
+    std::cout << "  (Diagonal passages, in every direction)\n";
+    CHECK(rasterize(0, 0, 2, 2) ==
+          std::vector<Point>({Point(0, 0), Point(1, 1), Point(2, 2)}));
+    CHECK(rasterize(2, 0, 0, 2) ==
+          std::vector<Point>({Point(2, 0), Point(1, 1), Point(0, 2)}));
+    CHECK(rasterize(0, 2, 2, 0) ==
+          std::vector<Point>({Point(0, 2), Point(1, 1), Point(2, 0)}));
+  }
+
+  SUBCASE("Any distance between cells") {
+    std::cout << "  (Any distance between cells)\n";
+    for (int d = 1; d < 6; d++) {
+      auto points = rasterize(d, d, 2 * d, 0);
+      CHECK(points.size() == static_cast<size_t>(d + 1));
+      CHECK(points.front() == Point(d, d));
+      CHECK(points.back() == Point(2 * d, 0));
+    }
+    CHECK(rasterize(3, 3, 3, 3) == std::vector<Point>({Point(3, 3)}));
+  }
+
+  SUBCASE("Other slopes step one pixel at a time") {
+    std::cout << "  (Other slopes step one pixel at a time)\n";
+    auto points = rasterize(0, 0, 5, 2);
+    CHECK(points.size() == 6);
+    CHECK(points.back() == Point(5, 2));
+    for (unsigned int i = 1; i < points.size(); i++) {
+      const auto [x0, y0] = points[i - 1];
+      const auto [x1, y1] = points[i];
+      CHECK(x1 - x0 == 1);
+      CHECK(y1 - y0 >= 0);
+      CHECK(y1 - y0 <= 1);
+    }
+  }
+}
@@ -0,0 +1,162 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+
+#include "cell.h"
+#include "doctest.h"
+#include "hunt-and-kill.h"
+#include "sharded-maze.h"
+
+// a canvas as wide as a chain of panels.
+struct ChainCanvas {
+  int w;
+  int h = 64;
+  ChainCanvas(int panels) : w(64 * panels){};
+  int width() { return this->w; };
+  int height() { return this->h; };
+  std::vector<std::tuple<int, int, int, int, int> > pixel_calls;
+  void SetPixel(int x, int y, int r, int g, int b) {
+    this->pixel_calls.push_back(
+        std::tuple<int, int, int, int, int>(x, y, r, g, b));
+  };
+  std::vector<std::tuple<int, int, int, int, int> > getCallsForSpecificPixel(
+      int tx, int ty) {
+    std::vector<std::tuple<int, int, int, int, int> > matching;
+    for (const auto& call : this->pixel_calls) {
+      auto const [x, y, r, g, b] = call;
+      if (x == tx && y == ty) {
+        matching.push_back(call);
+      }
+    }
+    return matching;
+  }
+};
+
+using ChainMaze = ShardedMaze<HuntAndKillStrategy<>, Cell, ChainCanvas>;
+
+TEST_CASE("A maze can be sharded across chained panels.") {
+  std::cout << "(A maze can be sharded across chained panels)\n";
+  ChainCanvas* c = new ChainCanvas(4);
+  ChainMaze m(c, 64);
+  std::atomic<bool> interrupt(false);
+
+  SUBCASE("Each panel gets a shard of its own") {
+    std::cout << "  (Each panel gets a shard of its own)\n";
+    CHECK(m.numShards() == 4);
+    for (unsigned int k = 0; k < m.numShards(); k++) {
+      CHECK(m.getShard(k).generatePixelMap().size() == 64);
+      CHECK(m.getShard(k).generatePixelMap()[0].size() == 64);
+    }
+    CHECK_THROWS_AS(ChainMaze(c, 60), const char*);
+  }
+
+  SUBCASE("Every shard is generated and drawn on its own panel") {
+    std::cout << "  (Every shard is generated and drawn on its own panel)\n";
+    auto start = std::chrono::high_resolution_clock::now();
+    m.generate(interrupt, 0);
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    std::cout << "    generated 4 panels in " << duration.count()
+              << " microseconds.\n";
+    CHECK(m.generated);
+    for (unsigned int k = 0; k < m.numShards(); k++) {
+      CHECK(m.getShard(k).generated);
+      auto map = m.getShard(k).generatePixelMap();
+      for (unsigned int i = 0; i < map.size(); i += 2) {
+        for (unsigned int j = 0; j < map[i].size(); j += 2) {
+          CHECK(map[i][j] != std::make_tuple(255u, 255u, 255u));
+        }
+      }
+    }
+    for (const auto& call : c->pixel_calls) {
+      CHECK(std::get<0>(call) < 64 * 4);
+      CHECK(std::get<1>(call) < 64);
+    }
+
+    SUBCASE("Each seam is opened once, in the same place every time") {
+      std::cout
+          << "    (Each seam is opened once, in the same place every time)\n";
+      CHECK(m.getSeamRow(0) == 5);
+      CHECK(m.getSeamRow(1) == 16);
+      CHECK(m.getSeamRow(2) == 26);
+      CHECK(m.getSeam(1).west_cell == 16 * 32 + 31);
+      CHECK(m.getSeam(1).east_cell == 16 * 32);
+      // each shard's grid has an exit at each end of its own seams, and
+      // nowhere else.
+      for (unsigned int k = 0; k < m.numShards(); k++) {
+        auto& shard = m.getShard(k);
+        unsigned int exits = 0;
+        for (unsigned int id = 0; id < 32 * 32; id++) {
+          for (unsigned int d = 0; d < NUM_DIRECTIONS; d++) {
+            exits += shard.queryExit(id, d) == CONNECTED;
+          }
+        }
+        CHECK(exits == (k == 0 || k + 1 == m.numShards() ? 1u : 2u));
+        if (k + 1 < m.numShards()) {
+          CHECK(shard.queryExit(m.getSeam(k).west_cell, RIGHT) == CONNECTED);
+        }
+        if (k > 0) {
+          CHECK(shard.queryExit(m.getSeam(k - 1).east_cell, LEFT) ==
+                CONNECTED);
+        }
+      }
+      // the opening is part of the west shard's pixel map, so it is drawn
+      // with everything else.
+      for (unsigned int k = 0; k + 1 < m.numShards(); k++) {
+        const auto& map = m.getShard(k).generatePixelMap();
+        for (unsigned int row = 0; row < 32; row++) {
+          const bool open = map[row * 2][63] == std::make_tuple(0u, 255u, 0u);
+          CHECK(open == (row == m.getSeamRow(k)));
+        }
+        auto p = c->getCallsForSpecificPixel(64 * k + 63, m.getSeamRow(k) * 2);
+        REQUIRE(p.size() > 0);
+        CHECK(std::get<3>(p.back()) == 255);
+      }
+    }
+
+    SUBCASE("A seam is kept when its shard is checkpointed") {
+      std::cout << "    (A seam is kept when its shard is checkpointed)\n";
+      const std::string path = "test-sharded-maze-checkpoint.bin";
+      m.getShard(1).saveCheckpoint(path);
+      std::mutex lock;
+      PanelCanvas<ChainCanvas> panel(c, &lock, 64, 64);
+      ChainMaze::Shard resumed(&panel);
+      resumed.loadCheckpoint(path);
+      CHECK(resumed.queryExit(m.getSeam(0).east_cell, LEFT) == CONNECTED);
+      CHECK(resumed.queryExit(m.getSeam(1).west_cell, RIGHT) == CONNECTED);
+      CHECK(resumed.countDeadEnds() == m.getShard(1).countDeadEnds());
+      CHECK(resumed.generatePixelMap() == m.getShard(1).generatePixelMap());
+      std::remove(path.c_str());
+    }
+  }
+
+  SUBCASE("An interrupted maze is left unstitched") {
+    std::cout << "  (An interrupted maze is left unstitched)\n";
+    interrupt = true;
+    m.generate(interrupt, 0);
+    CHECK(!m.generated);
+  }
+  delete c;
+}
+
+TEST_CASE("A sharded maze can be reproduced from a seed.") {
+  std::cout << "(A sharded maze can be reproduced from a seed)\n";
+  ChainCanvas* c = new ChainCanvas(3);
+  ChainCanvas* c2 = new ChainCanvas(3);
+  ChainMaze m(c, 64, Rng(5));
+  ChainMaze same(c2, 64, Rng(5));
+  std::atomic<bool> interrupt(false);
+  m.generate(interrupt, 0);
+  same.generate(interrupt, 0);
+  for (unsigned int k = 0; k < m.numShards(); k++) {
+    CHECK(m.getShard(k).generatePixelMap() ==
+          same.getShard(k).generatePixelMap());
+  }
+  // each shard draws from a stream of its own.
+  CHECK(m.getShard(0).generatePixelMap() != m.getShard(1).generatePixelMap());
+  delete c;
+  delete c2;
+}